@@ -4,13 +4,25 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec2 a_TexCoord;
+// Per instance, see Renderer::InstanceData
+layout(location = 3) in mat4 a_Transform;
+layout(location = 7) in vec2 a_Tiling;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+// Per-frame globals, see Renderer::FrameUniforms
+layout(std140) uniform Frame {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_CameraPosition; // xyz
+    vec4 u_SunDirection;   // xyz, w = intensity
+    vec4 u_SunColor;       // rgb
+    vec4 u_Viewport;       // xy = size in pixels, zw = 1 / size
+    vec4 u_Time;           // x = seconds, y = frame delta
+};
 
 void main()
 {
-    gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+    gl_Position = u_ViewProjection * a_Transform * vec4(a_Position, 1.0);
 }
 
 #type fragment
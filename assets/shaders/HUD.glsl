@@ -1,23 +1,20 @@
 #type vertex
 #version 410 core
 
-layout(location = 0) in vec2 a_Position;
-layout(location = 1) in vec2 a_TexCoord;
+layout(location = 0) in vec2 a_Position; // Pixels
+layout(location = 1) in vec2 a_TexCoord; // Font atlas
+layout(location = 2) in vec4 a_Color;
 
 out vec2 v_TexCoord;
+out vec4 v_Color;
 
 uniform mat4 u_Projection;
-uniform mat4 u_Transform;
-uniform vec4 u_UVBounds; // x: minU, y: minV, z: maxU, w: maxV
 
 void main()
 {
-    // Remap standard 0-1 UVs to the specific bounds in the atlas
-    v_TexCoord = vec2(
-        u_UVBounds.x + a_TexCoord.x * (u_UVBounds.z - u_UVBounds.x),
-        u_UVBounds.y + a_TexCoord.y * (u_UVBounds.w - u_UVBounds.y)
-    );
-    gl_Position = u_Projection * u_Transform * vec4(a_Position, 0.0, 1.0);
+    v_TexCoord = a_TexCoord;
+    v_Color = a_Color;
+    gl_Position = u_Projection * vec4(a_Position, 0.0, 1.0);
 }
 
 #type fragment
@@ -26,17 +23,13 @@ void main()
 layout(location = 0) out vec4 color;
 
 in vec2 v_TexCoord;
+in vec4 v_Color;
 
-uniform vec4 u_Color;
 uniform sampler2D u_Texture;
-uniform bool u_UseTexture;
 
 void main()
 {
-    if (u_UseTexture) {
-        float alpha = texture(u_Texture, v_TexCoord).r;
-        color = vec4(u_Color.rgb, u_Color.a * alpha);
-    } else {
-        color = u_Color;
-    }
+    // Glyphs are coverage in the red channel; solid quads sample a white cell
+    float alpha = texture(u_Texture, v_TexCoord).r;
+    color = vec4(v_Color.rgb, v_Color.a * alpha);
 }
@@ -4,18 +4,30 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec2 a_TexCoord;
+// Per instance, see Renderer::InstanceData
+layout(location = 3) in mat4 a_Transform;
+layout(location = 7) in vec2 a_Tiling;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+// Per-frame globals, see Renderer::FrameUniforms
+layout(std140) uniform Frame {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_CameraPosition; // xyz
+    vec4 u_SunDirection;   // xyz, w = intensity
+    vec4 u_SunColor;       // rgb
+    vec4 u_Viewport;       // xy = size in pixels, zw = 1 / size
+    vec4 u_Time;           // x = seconds, y = frame delta
+};
 
 out vec3 v_Normal;
 out vec3 v_FragPos;
 out vec2 v_TexCoord;
 
 void main() {
-    v_Normal = mat3(transpose(inverse(u_Transform))) * a_Normal;
-    v_FragPos = vec3(u_Transform * vec4(a_Position, 1.0));
-    v_TexCoord = a_TexCoord;
+    v_Normal = mat3(transpose(inverse(a_Transform))) * a_Normal;
+    v_FragPos = vec3(a_Transform * vec4(a_Position, 1.0));
+    v_TexCoord = a_TexCoord * a_Tiling;
     
     gl_Position = u_ViewProjection * vec4(v_FragPos, 1.0);
 }
@@ -25,31 +37,34 @@ void main() {
 
 layout(location = 0) out vec4 color;
 
-struct DirLight {
-    vec3 Direction;
-    vec3 Color;
-    float Intensity;
-};
-
 in vec3 v_Normal;
 in vec3 v_FragPos;
 in vec2 v_TexCoord;
 
-uniform DirLight u_DirLight;
+layout(std140) uniform Frame {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_CameraPosition; // xyz
+    vec4 u_SunDirection;   // xyz, w = intensity
+    vec4 u_SunColor;       // rgb
+    vec4 u_Viewport;       // xy = size in pixels, zw = 1 / size
+    vec4 u_Time;           // x = seconds, y = frame delta
+};
+
 uniform sampler2D u_Texture;
-uniform vec2 u_Tiling;
 
 void main() {
     // Ambient
     float ambientStrength = 0.1;
-    vec3 ambient = ambientStrength * u_DirLight.Color;
+    vec3 ambient = ambientStrength * u_SunColor.rgb;
     
     // Diffuse
     vec3 norm = normalize(v_Normal);
-    vec3 lightDir = normalize(-u_DirLight.Direction);
+    vec3 lightDir = normalize(-u_SunDirection.xyz);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * u_DirLight.Color;
+    vec3 diffuse = diff * u_SunColor.rgb;
     
-    vec4 texColor = texture(u_Texture, v_TexCoord * u_Tiling);
-    color = vec4((ambient + diffuse) * texColor.rgb, 1.0) * u_DirLight.Intensity;
+    vec4 texColor = texture(u_Texture, v_TexCoord);
+    color = vec4((ambient + diffuse) * texColor.rgb, 1.0) * u_SunDirection.w;
 }
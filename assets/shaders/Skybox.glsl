@@ -3,7 +3,18 @@
 
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection;
+// Per-frame globals, see Renderer::FrameUniforms
+layout(std140) uniform Frame {
+    mat4 u_ViewProjection;
+    mat4 u_View;
+    mat4 u_Projection;
+    vec4 u_CameraPosition; // xyz
+    vec4 u_SunDirection;   // xyz, w = intensity
+    vec4 u_SunColor;       // rgb
+    vec4 u_Viewport;       // xy = size in pixels, zw = 1 / size
+    vec4 u_Time;           // x = seconds, y = frame delta
+};
+
 uniform mat4 u_Transform;
 
 out vec3 v_Position;
@@ -11,10 +22,9 @@ out vec3 v_Position;
 void main()
 {
     v_Position = a_Position;
-    // We want the skybox to be centered around the camera, so we remove the translation from the view matrix
-    // However, our u_ViewProjection might already have it. 
-    // We'll handle centering in the Application side by setting the skybox position to the camera position.
-    gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+    // Rotation only, so the sky stays centred on the camera
+    mat4 view = mat4(mat3(u_View));
+    gl_Position = u_Projection * view * u_Transform * vec4(a_Position, 1.0);
     // Force depth to be max
     gl_Position = gl_Position.xyww; 
 }
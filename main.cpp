@@ -1,6 +1,8 @@
 #include "Core/Application.h"
 #include "Core/Logger.h"
+#include <cstdlib>
 #include <memory>
+#include <string>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -36,8 +38,24 @@ int main(int argc, char **argv) {
     S67_CORE_INFO("argv[{0}] = {1}", i, argv[i]);
   }
 
-  auto app =
-      std::make_unique<S67::Application>(argv[0], argc > 1 ? argv[1] : "");
+  // Usage: Source67 [level.s67 | manifest.source] [--headless [--ticks N]
+  //                                                            [--realtime]]
+  S67::HeadlessSpecification headless;
+  std::string arg;
+  for (int i = 1; i < argc; i++) {
+    std::string current = argv[i];
+    if (current == "--headless") {
+      headless.Enabled = true;
+    } else if (current == "--realtime") {
+      headless.RealTime = true;
+    } else if (current == "--ticks" && i + 1 < argc) {
+      headless.TickCount = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg.empty()) {
+      arg = current;
+    }
+  }
+
+  auto app = std::make_unique<S67::Application>(argv[0], arg, headless);
   app->Run();
   // No delete needed - automatic cleanup
 
@@ -16,17 +16,20 @@
 
 #include "Core/Input.h"
 #include "Core/PlatformUtils.h"
+#include "Core/Timer.h"
 #include "Game/Console/ConVar.h"
 #include "Game/Console/Console.h"
 #include "Game/Console/ConsolePanel.h"
 #include "ImGui/Panels/ContentBrowserPanel.h"
 #include "ImGuizmo/ImGuizmo.h"
 #include "Physics/PhysicsShapes.h"
+#include <Jolt/Physics/StateRecorderImpl.h>
 #include "Physics/PlayerController.h"
 #include "Renderer/Framebuffer.h"
 #include "Renderer/SceneSerializer.h"
 #include "Renderer/ScriptableEntity.h"
 #include "Renderer/ScriptRegistry.h"
+#include "Renderer/TextureCache.h"
 #include "Scripting/LuaScriptEngine.h"
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
@@ -40,7 +43,11 @@
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <csignal>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -49,11 +56,18 @@
 
 namespace S67 {
 
+// The edit-mode scene, taken on Play and put back on Stop: every component
+// (page copies out of the registry) plus Jolt's own state for the bodies
 struct SceneBackup {
-  struct TransformData {
-    glm::vec3 Position, Rotation, Scale;
-  };
-  std::unordered_map<void *, TransformData> Data;
+  EntityRegistry::Snapshot Entities;
+  JPH::StateRecorderImpl Physics;
+  JPH::BodyIDVector Bodies; // Bodies in the world when Physics was saved
+
+  void Clear() {
+    Entities.Clear();
+    Physics.Clear();
+    Bodies.clear();
+  }
 };
 static SceneBackup s_SceneBackup;
 
@@ -62,8 +76,25 @@ Application *Application::s_Instance = nullptr;
 static ConVar* s_ClShowFPS = nullptr;
 static ConVar* s_SvTickRate = nullptr;
 
+static ConVar host_thread_mode(
+    "host_thread_mode", "1", FCVAR_ARCHIVE,
+    "Run game ticks on a separate simulation thread (applies on next Play)");
+static ConVar host_maxticks(
+    "host_maxticks", "10", FCVAR_ARCHIVE,
+    "Most game ticks run in one frame while catching up; whole ticks beyond "
+    "this are dropped",
+    true, 1.0f, false, 0.0f);
+static ConVar r_frustumcull(
+    "r_frustumcull", "1", FCVAR_NONE,
+    "Skip drawing entities whose bounds are outside the camera's view");
+
+static std::atomic<bool> s_HeadlessInterrupted{false};
+static void OnHeadlessSignal(int) { s_HeadlessInterrupted = true; }
+
 Application::Application(const std::string &executablePath,
-                         const std::string &arg) {
+                         const std::string &arg,
+                         const HeadlessSpecification &headless)
+    : m_Headless(headless) {
   S67_CORE_ASSERT(!s_Instance, "Application already exists!");
   s_Instance = this;
 
@@ -107,13 +138,18 @@ Application::Application(const std::string &executablePath,
                   currentPath.string());
   }
 
-  S67_CORE_INFO("Initializing Window...");
-  m_Window = std::unique_ptr<Window>(Window::Create());
-  m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
-  m_Window->SetIcon(ResolveAssetPath("assets/engine/level_icon.png").string());
+  if (!m_Headless.Enabled) {
+    S67_CORE_INFO("Initializing Window...");
+    m_Window = std::unique_ptr<Window>(Window::Create());
+    m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
+    m_Window->SetIcon(
+        ResolveAssetPath("assets/engine/level_icon.png").string());
 
-  S67_CORE_INFO("Initializing Renderer...");
-  Renderer::Init();
+    S67_CORE_INFO("Initializing Renderer...");
+    Renderer::Init();
+  } else {
+    S67_CORE_INFO("Running headless: skipping Window, Renderer and ImGui");
+  }
 
   S67_CORE_INFO("Initializing Physics...");
   PhysicsSystem::Init();
@@ -123,9 +159,12 @@ Application::Application(const std::string &executablePath,
   m_Camera->SetPosition({0.0f, 2.0f, 8.0f});
   m_Camera->SetPosition({0.0f, 2.0f, 8.0f});
   // m_PlayerController managed by Scene Script now
+  m_PlayerCamera =
+      CreateRef<PerspectiveCamera>(45.0f, 1280.0f / 720.0f, 0.1f, 100.0f);
+  m_PlayerCamera->SetPosition(m_Camera->GetPosition());
 
   // Initialize tick system game state
-  m_PreviousFrameTime = glfwGetTime();
+  m_PreviousFrameTime = m_Headless.Enabled ? 0.0 : glfwGetTime();
   m_CurrentState.player_position =
       m_Camera->GetPosition() - glm::vec3(0.0f, 1.7f, 0.0f);
   m_CurrentState.yaw = -90.0f;
@@ -137,6 +176,7 @@ Application::Application(const std::string &executablePath,
   m_EditorCamera->SetPosition({5.0f, 5.0f, 15.0f});
 
   m_Scene = CreateScope<Scene>();
+  m_LevelStreamer = CreateScope<LevelStreamer>();
   m_Sun.Direction = {-0.5f, -1.0f, -0.2f};
   m_Sun.Color = {1.0f, 0.95f, 0.8f}; // Warm sun color
   m_Sun.Intensity = 1.0f;
@@ -144,46 +184,51 @@ Application::Application(const std::string &executablePath,
   m_CameraController = CreateRef<CameraController>(m_Camera);
   m_EditorCameraController = CreateRef<CameraController>(m_EditorCamera);
   m_EditorCameraController->SetRotationEnabled(false); // Only via Right-Click
-  m_Window->SetCursorLocked(false);
   m_CursorLocked = false;
 
-  m_ImGuiLayer = CreateScope<ImGuiLayer>();
-  m_ImGuiLayer->OnAttach();
+  if (!m_Headless.Enabled) {
+    m_Window->SetCursorLocked(false);
 
-  m_SceneHierarchyPanel = CreateScope<SceneHierarchyPanel>(m_Scene);
-  m_ContentBrowserPanel = CreateScope<ContentBrowserPanel>();
-  m_ConsolePanel = CreateScope<ConsolePanel>();
-  m_Skybox = CreateScope<Skybox>(
-      ResolveAssetPath("assets/textures/sky-3.png").string());
-  LoadSettings();
+    m_ImGuiLayer = CreateScope<ImGuiLayer>();
+    m_ImGuiLayer->OnAttach();
 
-  if (!std::filesystem::exists("imgui.ini")) {
-    m_ResetLayoutOnNextFrame = true;
-  }
+    m_SceneHierarchyPanel = CreateScope<SceneHierarchyPanel>(m_Scene);
+    m_ContentBrowserPanel = CreateScope<ContentBrowserPanel>();
+    m_ConsolePanel = CreateScope<ConsolePanel>();
+    m_Skybox = CreateScope<Skybox>(
+        ResolveAssetPath("assets/textures/sky-3.png").string());
+    LoadSettings();
 
-  FramebufferSpecification fbSpec;
-  fbSpec.Width = 1280;
-  fbSpec.Height = 720;
-  m_SceneFramebuffer = Framebuffer::Create(fbSpec);
-  m_GameFramebuffer = Framebuffer::Create(fbSpec);
-  m_OutlineShader = Shader::Create(
-      ResolveAssetPath("assets/shaders/FlatColor.glsl").string());
+    if (!std::filesystem::exists("imgui.ini")) {
+      m_ResetLayoutOnNextFrame = true;
+    }
 
-  std::filesystem::path logoPath =
-      ResolveAssetPath("assets/engine/engine_logo.png");
-  if (std::filesystem::exists(logoPath)) {
-    m_LauncherLogo = Texture2D::Create(logoPath.string());
-  }
+    FramebufferSpecification fbSpec;
+    fbSpec.Width = 1280;
+    fbSpec.Height = 720;
+    m_SceneFramebuffer = Framebuffer::Create(fbSpec);
+    m_GameFramebuffer = Framebuffer::Create(fbSpec);
+    m_OutlineShader = Shader::Create(
+        ResolveAssetPath("assets/shaders/FlatColor.glsl").string());
+
+    std::filesystem::path logoPath =
+        ResolveAssetPath("assets/engine/engine_logo.png");
+    if (std::filesystem::exists(logoPath)) {
+      m_LauncherLogo = Texture2D::Create(logoPath.string());
+    }
 
-  InitDefaultAssets();
+    InitDefaultAssets();
+  }
 
   // Load Game Configuration (ConVars)
   S67_CORE_INFO("Loading game configuration...");
   Console::Get().Load("game.cfg");
 
-  // Initialize HUD Renderer
-  S67_CORE_INFO("Initializing HUD Renderer...");
-  HUDRenderer::Init();
+  if (!m_Headless.Enabled) {
+    // Initialize HUD Renderer
+    S67_CORE_INFO("Initializing HUD Renderer...");
+    HUDRenderer::Init();
+  }
 
   // Initialize Scripting
   S67_CORE_INFO("Initializing Lua Engine...");
@@ -191,9 +236,11 @@ Application::Application(const std::string &executablePath,
   
   // Script loading is now deferred to SetProjectRoot or DiscoverProject
 
-  m_HUDShader =
-      Shader::Create(ResolveAssetPath("assets/shaders/HUD.glsl").string());
-  HUDRenderer::SetShader(m_HUDShader);
+  if (!m_Headless.Enabled) {
+    m_HUDShader =
+        Shader::Create(ResolveAssetPath("assets/shaders/HUD.glsl").string());
+    HUDRenderer::SetShader(m_HUDShader);
+  }
 
   if (!arg.empty()) {
     std::string cleanArg = arg;
@@ -271,6 +318,8 @@ void Application::InitDefaultAssets() {
                         16, 17, 18, 18, 19, 16, 20, 21, 22, 22, 23, 20};
   vertexArray->SetIndexBuffer(
       IndexBuffer::Create(indices, sizeof(indices) / sizeof(uint32_t)));
+  vertexArray->SetBounds({glm::vec3(-1.0f), glm::vec3(1.0f)},
+                         {glm::vec3(0.0f), std::sqrt(3.0f)});
 
   m_DefaultShader =
       Shader::Create(ResolveAssetPath("assets/shaders/Lighting.glsl").string());
@@ -284,8 +333,10 @@ void Application::CreateTestScene() {
   auto &bodyInterface = PhysicsSystem::GetBodyInterface();
 
   // 1. Floor (Anchored)
-  auto floor =
-      CreateRef<Entity>("Floor", m_CubeMesh, m_DefaultShader, m_DefaultTexture);
+  auto floor = m_Scene->CreateEntity("Floor");
+  floor->Mesh = m_CubeMesh;
+  floor->MaterialShader = m_DefaultShader;
+  floor->Material.AlbedoMap = m_DefaultTexture;
   floor->Transform.Position = {0.0f, -2.0f, 0.0f};
   floor->Transform.Scale = {20.0f, 1.0f, 20.0f};
   floor->Anchored = true;
@@ -295,7 +346,7 @@ void Application::CreateTestScene() {
       JPH::Quat::sIdentity(),
       floor->Anchored ? JPH::EMotionType::Static : JPH::EMotionType::Dynamic,
       floor->Anchored ? Layers::NON_MOVING : Layers::MOVING);
-  floorSettings.mUserData = (uint64_t)floor.get();
+  floorSettings.mUserData = floor->GetHandle().ToUserData();
   floor->PhysicsBody = bodyInterface.CreateAndAddBody(
       floorSettings, JPH::EActivation::DontActivate);
   m_Scene->AddEntity(floor);
@@ -303,8 +354,10 @@ void Application::CreateTestScene() {
   // 2. Dynamic Cubes
   for (int i = 0; i < 5; i++) {
     std::string name = "Cube " + std::to_string(i);
-    auto cube =
-        CreateRef<Entity>(name, m_CubeMesh, m_DefaultShader, m_DefaultTexture);
+    auto cube = m_Scene->CreateEntity(name);
+    cube->Mesh = m_CubeMesh;
+    cube->MaterialShader = m_DefaultShader;
+    cube->Material.AlbedoMap = m_DefaultTexture;
     cube->Transform.Position = {(float)i * 2.0f - 4.0f, 10.0f + (float)i * 2.0f,
                                 0.0f};
     cube->Anchored = false;
@@ -316,7 +369,7 @@ void Application::CreateTestScene() {
         JPH::Quat::sIdentity(),
         cube->Anchored ? JPH::EMotionType::Static : JPH::EMotionType::Dynamic,
         cube->Anchored ? Layers::NON_MOVING : Layers::MOVING);
-    cubeSettings.mUserData = (uint64_t)cube.get();
+    cubeSettings.mUserData = cube->GetHandle().ToUserData();
     cube->PhysicsBody = bodyInterface.CreateAndAddBody(
         cubeSettings, JPH::EActivation::Activate);
     m_Scene->AddEntity(cube);
@@ -325,8 +378,11 @@ void Application::CreateTestScene() {
 }
 
 Application::~Application() {
+  StopSimulationThread();
+  s_SceneBackup.Clear();
   HUDRenderer::Shutdown();
-  m_ImGuiLayer->OnDetach();
+  if (m_ImGuiLayer)
+    m_ImGuiLayer->OnDetach();
   PhysicsSystem::Shutdown();
 }
 
@@ -337,15 +393,21 @@ void Application::OnScenePlay() {
   }
 
   m_Scene->EnsurePlayerExists();
+  // Re-merge whatever was edited out of the batches
+  m_StaticGeometryPending = true;
 
   if (m_SceneState == SceneState::Edit) {
     // Backup before first play
-    s_SceneBackup.Data.clear();
-    for (auto &entity : m_Scene->GetEntities()) {
-      s_SceneBackup.Data[entity.get()] = {entity->Transform.Position,
-                                          entity->Transform.Rotation,
-                                          entity->Transform.Scale};
-    }
+    Timer backupTimer;
+    JPH::PhysicsSystem &physics = PhysicsSystem::GetPhysicsSystem();
+    s_SceneBackup.Clear();
+    m_Scene->GetRegistry().SaveSnapshot(s_SceneBackup.Entities);
+    physics.SaveState(s_SceneBackup.Physics);
+    physics.GetBodies(s_SceneBackup.Bodies);
+    S67_CORE_INFO("Play snapshot: {0} entities, {1} KB physics state, {2:.2f} ms",
+                  s_SceneBackup.Entities.Handles.size(),
+                  s_SceneBackup.Physics.GetDataSize() / 1024,
+                  backupTimer.ElapsedMillis());
 
     float fov = 45.0f;
     glm::vec3 startPos = {0.0f, 2.0f, 0.0f};
@@ -370,11 +432,21 @@ void Application::OnScenePlay() {
       aspect = m_GameViewportSize.x / m_GameViewportSize.y;
 
     m_Camera->SetProjection(fov, aspect, 0.1f, 100.0f);
+
+    // Seed interpolation with the edit-time layout so the first frames
+    // before any tick has run do not pop
+    CaptureEntityStates(m_CurrentState.entities);
+    m_PreviousState = m_CurrentState;
+    m_Accumulator = 0.0;
+    m_TickStats.Reset();
   }
 
   m_Window->SetCursorLocked(true);
   m_CursorLocked = true;
   m_SceneState = SceneState::Play;
+
+  if (host_thread_mode.GetBool())
+    StartSimulationThread();
 }
 
 void Application::OnScenePause() {
@@ -391,6 +463,7 @@ void Application::OnScenePause() {
 }
 
 void Application::OnSceneStop() {
+  StopSimulationThread();
   m_SceneState = SceneState::Edit;
 
   // Re-enable ImGui mouse handling
@@ -400,25 +473,73 @@ void Application::OnSceneStop() {
   m_CursorLocked = false;
 
   // Restore
-  auto &bodyInterface = PhysicsSystem::GetBodyInterface();
-  for (auto &entity : m_Scene->GetEntities()) {
-    if (s_SceneBackup.Data.count(entity.get())) {
-      auto &data = s_SceneBackup.Data[entity.get()];
-      entity->Transform.Position = data.Position;
-      entity->Transform.Rotation = data.Rotation;
-      entity->Transform.Scale = data.Scale;
-
-      if (!entity->PhysicsBody.IsInvalid()) {
-        glm::quat q = glm::quat(glm::radians(entity->Transform.Rotation));
-        JPH::Quat jRotate(q.x, q.y, q.z, q.w);
+  if (!s_SceneBackup.Entities.IsEmpty()) {
+    Timer restoreTimer;
+    EntityRegistry &registry = m_Scene->GetRegistry();
+    auto &bodyInterface = PhysicsSystem::GetBodyInterface();
+    JPH::PhysicsSystem &physics = PhysicsSystem::GetPhysicsSystem();
+
+    // Entities spawned during play leave with the restore. Take their bodies
+    // out first, while their components still say which bodies they own.
+    std::vector<EntityHandle> saved = s_SceneBackup.Entities.Handles;
+    auto byValue = [](EntityHandle a, EntityHandle b) {
+      return a.Value < b.Value;
+    };
+    std::sort(saved.begin(), saved.end(), byValue);
+    for (const auto &entity : m_Scene->GetEntities()) {
+      if (entity->PhysicsBody.IsInvalid() ||
+          std::binary_search(saved.begin(), saved.end(), entity->GetHandle(),
+                             byValue))
+        continue;
+      bodyInterface.RemoveBody(entity->PhysicsBody);
+      bodyInterface.DestroyBody(entity->PhysicsBody);
+      entity->PhysicsBody = JPH::BodyID();
+    }
+
+    registry.RestoreSnapshot(s_SceneBackup.Entities);
+
+    // With the same bodies as when play started, Jolt puts back positions,
+    // velocities, sleep state and contacts exactly
+    JPH::BodyIDVector bodies;
+    physics.GetBodies(bodies);
+    bool exact = bodies == s_SceneBackup.Bodies;
+    if (exact) {
+      s_SceneBackup.Physics.Rewind();
+      exact = physics.RestoreState(s_SceneBackup.Physics);
+    }
+
+    if (!exact) {
+      // Entities were deleted during play and took their bodies with them:
+      // rebuild those, then pose every body from the restored Transforms
+      registry.UpdateWorldTransforms();
+      for (const auto &entity : m_Scene->GetEntities()) {
+        if (!entity->PhysicsBody.IsInvalid() &&
+            !bodyInterface.IsAdded(entity->PhysicsBody)) {
+          entity->PhysicsBody = JPH::BodyID();
+          if (entity->Collidable && entity->Name != "Player")
+            OnEntityCollidableChanged(entity);
+        }
+        if (entity->PhysicsBody.IsInvalid())
+          continue;
+
+        Transform pose = registry.GetWorldPose(entity->GetHandle());
+        glm::quat q = glm::quat(glm::radians(pose.Rotation));
         bodyInterface.SetPositionAndRotation(
             entity->PhysicsBody,
-            JPH::RVec3(data.Position.x, data.Position.y, data.Position.z),
-            jRotate, JPH::EActivation::DontActivate);
+            JPH::RVec3(pose.Position.x, pose.Position.y, pose.Position.z),
+            JPH::Quat(q.x, q.y, q.z, q.w), JPH::EActivation::DontActivate);
         bodyInterface.SetLinearAndAngularVelocity(
             entity->PhysicsBody, JPH::Vec3::sZero(), JPH::Vec3::sZero());
       }
     }
+
+    S67_CORE_INFO("Play snapshot restored ({0}) in {1:.2f} ms",
+                  exact ? "exact" : "bodies re-posed",
+                  restoreTimer.ElapsedMillis());
+    s_SceneBackup.Clear();
+
+    // The restore put back the meshes and textures entities had at Play
+    m_LevelStreamer->Refresh();
   }
 
   // Final sync: Update PlayerController and Camera to the restored state
@@ -444,7 +565,10 @@ void Application::SetProjectRoot(const std::filesystem::path &root) {
   if (m_ContentBrowserPanel)
     m_ContentBrowserPanel->SetRoot(root);
 
-  // Unload previous project modules
+  // Unload previous project modules, after the instances whose code lives in
+  // them
+  if (m_Scene)
+    m_Scene->DestroyScriptInstances();
   ScriptRegistry::Get().UnloadModules();
 
   // Scan for scripts in the project root
@@ -694,6 +818,10 @@ void Application::OnNewScene() {
     return;
   }
 
+  StopSimulationThread();
+  s_SceneBackup.Clear();
+  m_LevelStreamer->Reset(nullptr);
+  m_StaticGeometry.Clear();
   m_Scene->Clear();
   m_SceneHierarchyPanel->SetSelectedEntity(nullptr);
 
@@ -701,6 +829,8 @@ void Application::OnNewScene() {
   PhysicsSystem::Init();
 
   CreateTestScene();
+  m_LevelStreamer->Reset(m_Scene.get());
+  m_StaticGeometryPending = true;
 
   m_LevelLoaded = true;
   m_LevelFilePath = "Untitled.s67";
@@ -712,6 +842,10 @@ void Application::OnNewScene() {
 }
 
 void Application::CloseScene() {
+  StopSimulationThread();
+  s_SceneBackup.Clear();
+  m_LevelStreamer->Reset(nullptr);
+  m_StaticGeometry.Clear();
   m_Scene->Clear();
   m_SceneHierarchyPanel->SetSelectedEntity(nullptr);
   m_LevelLoaded = false;
@@ -805,21 +939,37 @@ void Application::OpenScene(const std::string &filepath) {
     return;
   }
 
+  StopSimulationThread();
+  s_SceneBackup.Clear();
   PhysicsSystem::Shutdown(); // Reset physics system to clear all bodies
   PhysicsSystem::Init();
   // m_PlayerController is managed by Scene's script system now
 
   DiscoverProject(std::filesystem::path(filepath));
+  m_LevelStreamer->Reset(nullptr);
+  m_StaticGeometry.Clear();
   SceneSerializer serializer(m_Scene.get(), m_ProjectRoot.string());
+  // Meshes and textures are left to the streamer, so the level opens without
+  // decoding every asset first
+  serializer.SetDeferAssets(!m_Headless.Enabled && LevelStreamer::IsEnabled());
   if (serializer.Deserialize(filepath)) {
     m_LevelLoaded = true;
     m_LevelFilePath = filepath;
     m_SceneModified = false;
-    m_Window->SetCursorLocked(false);
     m_CursorLocked = false;
-    ImGui::SetWindowFocus("Scene");
+    if (!m_Headless.Enabled) {
+      m_Window->SetCursorLocked(false);
+      ImGui::SetWindowFocus("Scene");
+    }
     auto &bodyInterface = PhysicsSystem::GetBodyInterface();
+    if (!m_Headless.Enabled) {
+      m_LevelStreamer->Reset(m_Scene.get());
+      m_StaticGeometryPending = true;
+    }
 
+    // Bodies are created first and then added to the broad phase a chunk at a
+    // time: one batched insert per chunk instead of a tree insert per body
+    std::vector<std::pair<int64_t, JPH::BodyID>> bodies;
     for (auto &entity : m_Scene->GetEntities()) {
 
       // Assign cube mesh if MeshPath is "Cube"
@@ -843,10 +993,37 @@ void Application::OpenScene(const std::string &filepath) {
                            : JPH::EMotionType::Dynamic,
           entity->Anchored ? Layers::NON_MOVING : Layers::MOVING);
 
-      settings.mUserData = (uint64_t)entity.get();
-      entity->PhysicsBody =
-          bodyInterface.CreateAndAddBody(settings, JPH::EActivation::Activate);
+      settings.mUserData = entity->GetHandle().ToUserData();
+      JPH::Body *body = bodyInterface.CreateBody(settings);
+      if (!body) {
+        S67_CORE_ERROR("Out of physics bodies, {0} has no collision",
+                       entity->Name);
+        continue;
+      }
+      entity->PhysicsBody = body->GetID();
+      bodies.push_back(
+          {m_LevelStreamer->GetChunkKey(entity->Transform.Position),
+           body->GetID()});
+    }
+
+    std::sort(bodies.begin(), bodies.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    JPH::BodyIDVector batch;
+    for (size_t begin = 0, end = 0; begin < bodies.size(); begin = end) {
+      batch.clear();
+      for (end = begin;
+           end < bodies.size() && bodies[end].first == bodies[begin].first;
+           end++)
+        batch.push_back(bodies[end].second);
+
+      JPH::BodyInterface::AddState state =
+          bodyInterface.AddBodiesPrepare(batch.data(), (int)batch.size());
+      bodyInterface.AddBodiesFinalize(batch.data(), (int)batch.size(), state,
+                                      JPH::EActivation::Activate);
     }
+    if (!bodies.empty())
+      PhysicsSystem::GetPhysicsSystem().OptimizeBroadPhase();
+
     m_Scene->EnsurePlayerExists();
   }
 }
@@ -874,7 +1051,7 @@ void Application::OnEntityCollidableChanged(Ref<Entity> entity) {
         entity->Anchored ? JPH::EMotionType::Static : JPH::EMotionType::Dynamic,
         entity->Anchored ? Layers::NON_MOVING : Layers::MOVING);
 
-    settings.mUserData = (uint64_t)entity.get();
+    settings.mUserData = entity->GetHandle().ToUserData();
 
     entity->PhysicsBody =
         bodyInterface.CreateAndAddBody(settings, JPH::EActivation::Activate);
@@ -885,6 +1062,8 @@ void Application::OnEntityCollidableChanged(Ref<Entity> entity) {
 }
 
 void Application::OnEvent(Event &e) {
+  SimulationLock simLock(m_SimulationMutex);
+
   // 1. Console Toggle (Global Priority)
   if (e.GetEventType() == EventType::KeyPressed) {
     auto &ek = (KeyPressedEvent &)e;
@@ -978,18 +1157,11 @@ void Application::OnEvent(Event &e) {
           glm::vec3 rayDirection =
               glm::normalize(glm::vec3(worldRayFar - worldRayNear));
 
-          JPH::BodyID hitID =
-              PhysicsSystem::Raycast(rayOrigin, rayDirection, 1000.0f);
-          if (!hitID.IsInvalid()) {
-            for (auto &entity : m_Scene->GetEntities()) {
-              if (entity->PhysicsBody == hitID) {
-                m_SceneHierarchyPanel->SetSelectedEntity(entity);
-                break;
-              }
-            }
-          } else {
-            m_SceneHierarchyPanel->SetSelectedEntity(nullptr);
-          }
+          // Against entity bounds rather than physics bodies, so
+          // non-collidable entities can be picked too
+          EntityHandle hit = m_Scene->GetRegistry().Raycast(
+              rayOrigin, rayDirection, 1000.0f);
+          m_SceneHierarchyPanel->SetSelectedEntity(m_Scene->GetEntity(hit));
         }
       }
 
@@ -1087,6 +1259,11 @@ void Application::OnEvent(Event &e) {
 }
 
 void Application::Run() {
+  if (m_Headless.Enabled) {
+    RunHeadless();
+    return;
+  }
+
   m_PreviousFrameTime = glfwGetTime();
 
   while (m_Running) {
@@ -1099,62 +1276,311 @@ void Application::Run() {
     m_GameFPS =
         (frame_time > 0.0) ? static_cast<float>(1.0 / frame_time) : 0.0f;
 
-    // PHASE 2: Prevent spiral of death (lag spike safety)
-    if (frame_time > MAX_FRAME_TIME) {
-      frame_time = MAX_FRAME_TIME; // Clamp to max 250ms
+    // PHASES 2-4: Run all due ticks here, unless the simulation thread owns
+    // them, in which case pick up the newest snapshot it published
+    float alpha = 0.0f;
+    if (m_SimulationThread.joinable()) {
+      m_Snapshots.Fetch();
+      const GameStateSnapshot &snapshot = m_Snapshots.GetReadBuffer();
+      m_RenderPrevious = &snapshot.previous;
+      m_RenderCurrent = &snapshot.current;
+
+      // Same alpha the single-threaded loop would see right now
+      double residue =
+          snapshot.accumulator + (glfwGetTime() - snapshot.timestamp);
+      alpha = static_cast<float>(
+          std::clamp(residue / m_TickDuration, 0.0, 1.0));
+    } else {
+      AdvanceSimulation(frame_time);
+      m_RenderPrevious = &m_PreviousState;
+      m_RenderCurrent = &m_CurrentState;
+      alpha = static_cast<float>(m_Accumulator / m_TickDuration);
     }
 
-    // PHASE 3: Accumulate real time
-    m_Accumulator += frame_time;
+    // PHASE 5: Render frame with interpolation
+    RenderFrame(alpha);
 
-    // PHASE 4: Process all due physics ticks
-    int tick_count = 0;
-    while (m_Accumulator >= m_TickDuration) {
-      // Save previous state for interpolation
-      m_PreviousState = m_CurrentState;
+    // PHASE 6: Window update (swap buffers, poll events)
+    m_Window->OnUpdate();
+    if (m_SimulationThread.joinable())
+      Input::SampleState();
 
-      // Run one physics tick with fixed delta time
-      UpdateGameTick(m_TickDuration);
+    // PHASE 7: Apply FPS cap if enabled (sleep, then spin only the tail)
+    m_FramePacer.SetTargetRate(m_FPSCap);
+    m_FramePacer.Wait();
+  }
+}
 
-      // Deduct from accumulator
-      m_Accumulator -= m_TickDuration;
-      tick_count++;
-      m_TickNumber++;
+void Application::RunHeadless() {
+  if (!m_LevelLoaded) {
+    S67_CORE_ERROR("Headless: no level loaded (pass a .s67 level or a .source "
+                   "project with a DefaultLevel)");
+    return;
+  }
+
+  s_HeadlessInterrupted = false;
+  std::signal(SIGINT, OnHeadlessSignal);
+  std::signal(SIGTERM, OnHeadlessSignal);
+
+  // Same entry as OnScenePlay, minus the cursor/viewport handling
+  m_Scene->EnsurePlayerExists();
+  m_Scene->InstantiateScripts();
+  if (Ref<Entity> player = m_Scene->FindEntityByName("Player")) {
+    if (auto *pc = player->GetScript<PlayerController>()) {
+      pc->Reset(player->Transform.Position);
+      pc->SetRotation(player->Transform.Rotation.y, player->Transform.Rotation.x);
     }
+  }
+  m_SceneState = SceneState::Play;
 
-    // PHASE 5: Render frame with interpolation
-    float alpha = static_cast<float>(m_Accumulator / m_TickDuration);
-    RenderFrame(alpha);
+  S67_CORE_INFO("Headless: simulating '{0}' at {1} Hz, {2} ticks, {3}",
+                m_LevelFilePath, m_TickRate,
+                m_Headless.TickCount > 0 ? std::to_string(m_Headless.TickCount)
+                                         : std::string("unlimited"),
+                m_Headless.RealTime ? "real time" : "as fast as possible");
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  Clock::time_point nextTick = start;
+  Clock::time_point reportStart = start;
+
+  uint64_t ticksRun = 0;
+  uint64_t reportTicks = 0;
+  double simulatedTime = 0.0;
+  double totalTickTime = 0.0, maxTickTime = 0.0;
+  double reportTickTime = 0.0, reportMaxTickTime = 0.0;
+
+  while (m_Running && !s_HeadlessInterrupted) {
+    if (m_Headless.TickCount > 0 && ticksRun >= m_Headless.TickCount)
+      break;
 
-    // PHASE 6: Window update (swap buffers, poll events)
-    m_Window->OnUpdate();
+    Clock::time_point tickStart = Clock::now();
+
+    m_PreviousState = m_CurrentState;
+    UpdateGameTick(m_TickDuration);
+    m_TickNumber++;
+    ticksRun++;
+    reportTicks++;
+    simulatedTime += m_TickDuration;
+
+    Clock::time_point tickEnd = Clock::now();
+    double tickTime = std::chrono::duration<double>(tickEnd - tickStart).count();
+    totalTickTime += tickTime;
+    reportTickTime += tickTime;
+    maxTickTime = std::max(maxTickTime, tickTime);
+    reportMaxTickTime = std::max(reportMaxTickTime, tickTime);
+
+    double reportElapsed =
+        std::chrono::duration<double>(tickEnd - reportStart).count();
+    if (reportElapsed >= 1.0) {
+      S67_CORE_INFO("Headless: tick {0} | {1:.1f} ticks/s | avg {2:.3f} ms | "
+                    "max {3:.3f} ms",
+                    m_TickNumber, reportTicks / reportElapsed,
+                    reportTickTime / reportTicks * 1000.0,
+                    reportMaxTickTime * 1000.0);
+      reportStart = tickEnd;
+      reportTicks = 0;
+      reportTickTime = 0.0;
+      reportMaxTickTime = 0.0;
+    }
 
-    // PHASE 7: Apply FPS cap if enabled (High-precision hybrid wait)
-    if (m_FPSCap > 0) {
-      double target_frame_time = 1.0 / m_FPSCap;
-      double frame_end_time = glfwGetTime();
-      double elapsed = frame_end_time - current_frame_time;
-
-      if (elapsed < target_frame_time) {
-        double wait_time = target_frame_time - elapsed;
-
-        // 1. Precise sleep: Only sleep if we have more than a safe margin
-        // (20ms) to wait. This is necessary because the default Windows
-        // scheduler resolution is ~15.6ms. For anything shorter (like 144Hz or
-        // 240Hz targets), we MUST busy-wait to stay precise and avoid the "64
-        // FPS cap" issue.
-        if (wait_time > 0.020) {
-          std::this_thread::sleep_for(
-              std::chrono::duration<double>(wait_time - 0.018));
-        }
+    if (m_Headless.RealTime) {
+      nextTick += std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(m_TickDuration));
+      // Fell too far behind: drop the backlog like the windowed loop does
+      if (tickEnd - nextTick > std::chrono::duration<double>(MAX_FRAME_TIME))
+        nextTick = tickEnd;
+      std::this_thread::sleep_until(nextTick);
+    }
+  }
 
-        // 2. High-precision busy wait: Spin until we hit the exact microsecond
-        // target. This is extremely precise and works for all frame rates.
-        while (glfwGetTime() - current_frame_time < target_frame_time) {
-          // busy wait
-        }
-      }
+  double wallTime =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  if (ticksRun > 0 && wallTime > 0.0) {
+    S67_CORE_INFO("Headless: {0} ticks in {1:.3f} s | {2:.1f} ticks/s ({3:.2f}x "
+                  "real time) | avg {4:.3f} ms | max {5:.3f} ms",
+                  ticksRun, wallTime, ticksRun / wallTime,
+                  simulatedTime / wallTime, totalTickTime / ticksRun * 1000.0,
+                  maxTickTime * 1000.0);
+  }
+
+  m_SceneState = SceneState::Edit;
+}
+
+int Application::AdvanceSimulation(double frame_time) {
+  TickFrameSample sample;
+
+  // PHASE 2: Prevent spiral of death (lag spike safety)
+  if (frame_time > MAX_FRAME_TIME) {
+    sample.ClampedTime = static_cast<float>(frame_time - MAX_FRAME_TIME);
+    frame_time = MAX_FRAME_TIME; // Clamp to max 250ms
+  }
+
+  // PHASE 3: Accumulate real time
+  m_Accumulator += frame_time;
+
+  // PHASE 4: Process all due physics ticks, within the catch-up budget
+  int tick_count = 0;
+  const int max_ticks = host_maxticks.GetInt();
+  while (m_Accumulator >= m_TickDuration && tick_count < max_ticks) {
+    // Save previous state for interpolation
+    m_PreviousState = m_CurrentState;
+
+    // Run one physics tick with fixed delta time
+    Timer tickTimer;
+    UpdateGameTick(m_TickDuration);
+    float tickTime = tickTimer.Elapsed();
+    sample.TickTime += tickTime;
+    if (tickTime > m_TickDuration)
+      sample.LateTicks++;
+
+    // Deduct from accumulator
+    m_Accumulator -= m_TickDuration;
+    tick_count++;
+    m_TickNumber++;
+  }
+
+  // Over budget: drop the whole ticks still owed but keep the fraction so
+  // interpolation does not jump
+  if (m_Accumulator >= m_TickDuration) {
+    double residue = std::fmod(m_Accumulator, (double)m_TickDuration);
+    sample.BudgetDropped = static_cast<float>(m_Accumulator - residue);
+    m_Accumulator = residue;
+  }
+
+  if (m_SceneState == SceneState::Play) {
+    sample.Ticks = static_cast<uint32_t>(tick_count);
+    sample.AccumulatorResidue = static_cast<float>(m_Accumulator);
+    m_TickStats.Record(sample);
+  }
+  return tick_count;
+}
+
+void Application::StartSimulationThread() {
+  if (m_SimulationThread.joinable())
+    return;
+
+  // Scripts on the simulation thread read input through this sample
+  Input::SampleState();
+
+  GameStateSnapshot initial;
+  initial.previous = m_PreviousState;
+  initial.current = m_CurrentState;
+  initial.accumulator = m_Accumulator;
+  initial.timestamp = glfwGetTime();
+  initial.tick_number = m_TickNumber;
+  m_Snapshots.Reset(initial);
+
+  m_SimulationRunning = true;
+  m_SimulationThread = std::thread(&Application::SimulationThreadMain, this);
+  S67_CORE_INFO("Simulation thread started ({0} Hz)", m_TickRate);
+}
+
+void Application::StopSimulationThread() {
+  if (!m_SimulationThread.joinable())
+    return;
+
+  m_SimulationRunning = false;
+  m_SimulationThread.join();
+  m_RenderPrevious = &m_PreviousState;
+  m_RenderCurrent = &m_CurrentState;
+  S67_CORE_INFO("Simulation thread stopped");
+}
+
+void Application::SimulationThreadMain() {
+  double previous_time = glfwGetTime();
+
+  while (m_SimulationRunning) {
+    // Never block on the main thread indefinitely: it may be holding the
+    // lock while it waits in StopSimulationThread() for us to exit
+    SimulationLock lock(m_SimulationMutex, std::defer_lock);
+    if (!lock.try_lock_for(std::chrono::milliseconds(2)))
+      continue;
+
+    double current_time = glfwGetTime();
+    int tick_count = AdvanceSimulation(current_time - previous_time);
+    previous_time = current_time;
+
+    if (tick_count > 0) {
+      GameStateSnapshot &snapshot = m_Snapshots.GetWriteBuffer();
+      snapshot.previous = m_PreviousState;
+      snapshot.current = m_CurrentState;
+      snapshot.accumulator = m_Accumulator;
+      snapshot.timestamp = current_time;
+      snapshot.tick_number = m_TickNumber;
+      m_Snapshots.Publish();
     }
+
+    double until_next_tick = m_TickDuration - m_Accumulator;
+    lock.unlock();
+
+    if (until_next_tick > 0.0)
+      std::this_thread::sleep_for(
+          std::chrono::duration<double>(until_next_tick));
+  }
+}
+
+void Application::CaptureEntityStates(EntitySnapshot &snapshot) {
+  const auto &entities = m_Scene->GetEntities();
+  EntityRegistry &registry = m_Scene->GetRegistry();
+  const auto &handles = registry.GetHandles();
+  snapshot.Resize(entities.size());
+
+  // Runs between physics steps, so the world is ours and the locking body
+  // interface would only add overhead. Sleeping bodies cannot have moved.
+  auto &bodyInterface = PhysicsSystem::GetBodyInterfaceNoLock();
+  const bool syncBodies = m_SceneState == SceneState::Play;
+  Ref<Entity> player = syncBodies ? m_Scene->FindEntityByName("Player") : nullptr;
+
+  // Pull simulated body transforms back into their entities. Parented
+  // entities are placed by their parent instead.
+  for (size_t i = 0; i < handles.size() && syncBodies; i++) {
+    const JPH::BodyID body =
+        registry.Get<PhysicsBodyComponent>(handles[i]).PhysicsBody;
+    if (body.IsInvalid() || entities[i] == player ||
+        registry.GetParent(handles[i]).IsValid() ||
+        !bodyInterface.IsActive(body))
+      continue;
+
+    Transform &transform = registry.Get<Transform>(handles[i]);
+    JPH::RVec3 position;
+    JPH::Quat rotation;
+    bodyInterface.GetPositionAndRotation(body, position, rotation);
+    transform.Position = {position.GetX(), position.GetY(), position.GetZ()};
+    glm::quat q = {rotation.GetW(), rotation.GetX(), rotation.GetY(),
+                   rotation.GetZ()};
+    transform.Rotation = glm::degrees(glm::eulerAngles(q));
+  }
+
+  // Propagate through the hierarchy; only moved subtrees are rebuilt
+  registry.UpdateWorldTransforms();
+
+  for (size_t i = 0; i < handles.size(); i++) {
+    if (!registry.GetParent(handles[i]).IsValid()) {
+      const Transform &transform = registry.Get<Transform>(handles[i]);
+      snapshot.Set(i, handles[i], transform.Position,
+                   EntitySnapshot::RotationFromEuler(transform.Rotation),
+                   transform.Scale);
+      continue;
+    }
+
+    Transform pose = registry.GetWorldPose(handles[i]);
+    snapshot.Set(i, handles[i], pose.Position,
+                 EntitySnapshot::RotationFromEuler(pose.Rotation), pose.Scale);
+
+    // Parented bodies are pinned to their hierarchy pose, like kinematic
+    // ones, so a moving parent carries its children's colliders along
+    const JPH::BodyID body =
+        registry.Get<PhysicsBodyComponent>(handles[i]).PhysicsBody;
+    if (!syncBodies || body.IsInvalid())
+      continue;
+    glm::quat q = glm::quat(glm::radians(pose.Rotation));
+    bodyInterface.SetPositionAndRotationWhenChanged(
+        body, JPH::RVec3(pose.Position.x, pose.Position.y, pose.Position.z),
+        JPH::Quat(q.x, q.y, q.z, q.w), JPH::EActivation::Activate);
+    if (bodyInterface.IsActive(body))
+      bodyInterface.SetLinearAndAngularVelocity(body, JPH::Vec3::sZero(),
+                                                JPH::Vec3::sZero());
   }
 }
 
@@ -1185,13 +1611,26 @@ void Application::UpdateGameTick(float tick_dt) {
     Ref<Entity> playerEntity = m_Scene->FindEntityByName("Player");
     if (playerEntity) {
       if (auto *pc = playerEntity->GetScript<PlayerController>()) {
+        pc->SetSettings(playerEntity->Movement);
         m_CurrentState.player_position =
-            m_Camera->GetPosition() - glm::vec3(0.0f, 1.7f, 0.0f);
+            m_PlayerCamera->GetPosition() - glm::vec3(0.0f, 1.7f, 0.0f);
         m_CurrentState.player_velocity = pc->GetVelocity();
         m_CurrentState.yaw = pc->GetYaw();
         m_CurrentState.pitch = pc->GetPitch();
+        // Matches the game view, for scripts' view queries
+        m_PlayerCamera->SetProjection(playerEntity->CameraFOV, m_GameAspect,
+                                      0.1f, 100.0f);
+
+        // Keep the entity (inspector, scripts) in step with the controller
+        playerEntity->Transform.Position = m_CurrentState.player_position;
+        playerEntity->Transform.Rotation.x = pc->GetPitch();
+        playerEntity->Transform.Rotation.y = pc->GetYaw() + 90.0f;
       }
     }
+
+    // 4. Pull simulated body transforms back into their entities and
+    // capture this tick's transforms for render interpolation
+    CaptureEntityStates(m_CurrentState.entities);
   }
 
   // Note: Additional movement state (sprinting, crouching, etc.) could be
@@ -1845,6 +2284,101 @@ void Application::ResetLayout() {
   S67_CORE_INFO("Reset window layout to default");
 }
 
+void Application::ExtractRenderProxies(const Ref<Entity> &selectedEntity) {
+  const auto &entities = m_Scene->GetEntities();
+  m_RenderProxies.clear();
+  m_SelectedProxy = NO_PROXY;
+  m_PlayerProxy = NO_PROXY;
+  m_Culler.Clear();
+
+  if (m_StaticGeometryPending) {
+    m_StaticGeometry.Invalidate();
+    m_StaticGeometryPending = false;
+  }
+
+  // Batching reads Anchored and the scripts, which Lua changes on the
+  // simulation thread during Play
+  SimulationLock simLock(m_SimulationMutex);
+  m_StaticGeometry.Update(entities, m_RenderTransforms, *m_LevelStreamer);
+
+  for (size_t i = 0; i < entities.size(); i++) {
+    const Ref<Entity> &entity = entities[i];
+    if (!entity->Mesh || !entity->MaterialShader ||
+        !entity->MaterialShader->IsValid())
+      continue;
+
+    // Merged entities are drawn by their batch, but the selection still
+    // needs its own proxy for the outline
+    bool batched = m_StaticGeometry.Covers(*entity, m_RenderTransforms[i]);
+    if (batched && entity != selectedEntity)
+      continue;
+
+    if (entity == selectedEntity)
+      m_SelectedProxy = m_RenderProxies.size();
+    if (entity->Name == "Player")
+      m_PlayerProxy = m_RenderProxies.size();
+
+    RenderProxy &proxy = m_RenderProxies.emplace_back();
+    proxy.Transform = m_RenderTransforms[i];
+    proxy.Bounds = entity->Mesh->GetBounds().Transformed(proxy.Transform);
+    proxy.Mesh = entity->Mesh;
+    proxy.MaterialShader = entity->MaterialShader;
+    proxy.ProxyMaterial.AlbedoMap = entity->Material.AlbedoMap;
+    proxy.ProxyMaterial.Tiling = entity->Material.Tiling;
+    proxy.Batched = batched;
+    m_Culler.Add(proxy.Bounds);
+  }
+  m_StaticGeometry.EvictUnseen();
+  simLock.unlock();
+
+  // Batches are already in world space, with tiling baked in
+  for (const StaticGeometry::Batch &batch : m_StaticGeometry.GetBatches()) {
+    if (!batch.Mesh)
+      continue;
+    // Batches don't keep textures resident; one that streamed out leaves its
+    // members evicted by the next frame
+    Ref<Texture2D> albedo = batch.Albedo.lock();
+    if (batch.Textured && !albedo)
+      continue;
+    RenderProxy &proxy = m_RenderProxies.emplace_back();
+    proxy.Transform = glm::mat4(1.0f);
+    proxy.Bounds = batch.Bounds;
+    proxy.Mesh = batch.Mesh;
+    proxy.MaterialShader = batch.MaterialShader;
+    proxy.ProxyMaterial.AlbedoMap = albedo;
+    m_Culler.Add(proxy.Bounds);
+  }
+
+  // Each view keeps only the proxies inside its frustum
+  if (r_frustumcull.GetBool()) {
+    m_Culler.Cull(
+        Frustum::FromMatrix(m_EditorCamera->GetViewProjectionMatrix()),
+        m_SceneVisible);
+    m_Culler.Cull(Frustum::FromMatrix(m_Camera->GetViewProjectionMatrix()),
+                  m_GameVisible);
+  } else {
+    m_SceneVisible.assign(m_RenderProxies.size(), 1);
+    m_GameVisible.assign(m_RenderProxies.size(), 1);
+  }
+}
+
+void Application::SubmitRenderProxies(const std::vector<uint8_t> &visible,
+                                       size_t skip, CullingStats &stats) {
+  stats = CullingStats();
+  for (size_t i = 0; i < m_RenderProxies.size(); i++) {
+    if (i == skip || m_RenderProxies[i].Batched)
+      continue;
+    if (!visible[i]) {
+      stats.Culled++;
+      continue;
+    }
+    stats.Visible++;
+    const RenderProxy &proxy = m_RenderProxies[i];
+    Renderer::Submit(proxy.MaterialShader, proxy.Mesh, proxy.ProxyMaterial,
+                     proxy.Transform);
+  }
+}
+
 void Application::RenderFrame(float alpha) {
   // alpha is the interpolation factor between previous and current physics
   // states 0.0 = at previous tick state 0.5 = halfway between previous and
@@ -1869,6 +2403,7 @@ void Application::RenderFrame(float alpha) {
                               (uint32_t)m_GameViewportSize.y);
     m_Camera->SetProjection(45.0f, m_GameViewportSize.x / m_GameViewportSize.y,
                             0.1f, 100.0f);
+    m_GameAspect = m_GameViewportSize.x / m_GameViewportSize.y;
   }
 
   // Editor camera updates (still uses per-frame delta time, not affected by
@@ -1911,14 +2446,15 @@ void Application::RenderFrame(float alpha) {
     // Interpolate camera position for smooth rendering
     // Note: Physics ticks run in UpdateGameTick(), here we only interpolate
     // for display
-    glm::vec3 interpolated_position = glm::mix(
-        m_PreviousState.player_position, m_CurrentState.player_position, alpha);
+    glm::vec3 interpolated_position =
+        glm::mix(m_RenderPrevious->player_position,
+                 m_RenderCurrent->player_position, alpha);
 
     float interpolated_yaw =
-        glm::mix(m_PreviousState.yaw, m_CurrentState.yaw, alpha);
+        glm::mix(m_RenderPrevious->yaw, m_RenderCurrent->yaw, alpha);
 
     float interpolated_pitch =
-        glm::mix(m_PreviousState.pitch, m_CurrentState.pitch, alpha);
+        glm::mix(m_RenderPrevious->pitch, m_RenderCurrent->pitch, alpha);
 
     // Apply interpolated values to camera for smooth rendering
     m_Camera->SetPosition(interpolated_position + glm::vec3(0.0f, 1.7f, 0.0f));
@@ -1929,69 +2465,97 @@ void Application::RenderFrame(float alpha) {
   auto &bodyInterface = PhysicsSystem::GetBodyInterface();
   Ref<Entity> selectedEntity = m_SceneHierarchyPanel->GetSelectedEntity();
 
-  // 1. Scene View Pass
-  m_SceneFramebuffer->Bind();
-  glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
-  Renderer::BeginScene(*m_EditorCamera, m_Sun);
-  m_Skybox->Draw(*m_EditorCamera);
-  for (auto &entity : m_Scene->GetEntities()) {
-    // Real-time Player Sync (during Play/Pause)
-    if (entity->Name == "Player" && (m_SceneState == SceneState::Play ||
-                                     m_SceneState == SceneState::Pause)) {
-      if (auto *pc = entity->GetScript<PlayerController>()) {
-        pc->SetSettings(entity->Movement);
-        entity->Transform.Position =
-            m_Camera->GetPosition() - glm::vec3(0.0f, 1.7f, 0.0f);
-        entity->Transform.Rotation.x = pc->GetPitch();
-        entity->Transform.Rotation.y = pc->GetYaw() + 90.0f;
+  // Resolve every entity's world matrix once for both passes. In Play they
+  // come from the two tick states being interpolated, so nothing here reads
+  // state the simulation thread may be writing. Otherwise the cached world
+  // matrices are used; only Transforms edited since the last frame are
+  // rebuilt and pushed to their physics body so edits take effect.
+  const auto &entities = m_Scene->GetEntities();
+  m_RenderTransforms.resize(entities.size());
+  if (m_SceneState == SceneState::Play) {
+    EntitySnapshot::Interpolate(m_RenderPrevious->entities,
+                                m_RenderCurrent->entities, alpha,
+                                m_RenderEntities);
+    EntitySnapshot::BuildTransforms(m_RenderEntities, m_RenderTransforms);
+    m_RenderTransforms.resize(entities.size());
+
+    for (size_t i = 0; i < entities.size(); i++) {
+      if (i >= m_RenderEntities.Size() ||
+          m_RenderEntities.Handles[i] != entities[i]->GetHandle()) {
+        // Added or reordered since the last tick was captured
+        SimulationLock simLock(m_SimulationMutex);
+        m_RenderTransforms[i] =
+            m_Scene->GetRegistry().ComputeWorldTransform(
+                entities[i]->GetHandle());
       }
-      // No break here, we need to render it too
     }
+  } else {
+    SimulationLock simLock(m_SimulationMutex);
+    EntityRegistry &registry = m_Scene->GetRegistry();
+    Ref<Entity> player = m_Scene->FindEntityByName("Player");
+
+    // Only entities whose world placement changed (their own Transform or
+    // an ancestor's) get a new matrix and a body push
+    m_ChangedTransforms.clear();
+    registry.UpdateWorldTransforms(&m_ChangedTransforms);
+    for (EntityHandle handle : m_ChangedTransforms) {
+      const JPH::BodyID body =
+          registry.Get<PhysicsBodyComponent>(handle).PhysicsBody;
+      if (body.IsInvalid() || (player && player->GetHandle() == handle))
+        continue;
 
-    if (entity->Name != "Player" && !entity->PhysicsBody.IsInvalid()) {
-      if (m_SceneState == SceneState::Play) {
-        JPH::RVec3 position;
-        JPH::Quat rotation;
-        bodyInterface.GetPositionAndRotation(entity->PhysicsBody, position,
-                                             rotation);
-        entity->Transform.Position = {position.GetX(), position.GetY(),
-                                      position.GetZ()};
-        glm::quat q = {rotation.GetW(), rotation.GetX(), rotation.GetY(),
-                       rotation.GetZ()};
-        entity->Transform.Rotation = glm::degrees(glm::eulerAngles(q));
-      } else {
-        glm::quat q = glm::quat(glm::radians(entity->Transform.Rotation));
-        bodyInterface.SetPositionAndRotation(
-            entity->PhysicsBody,
-            JPH::RVec3(entity->Transform.Position.x,
-                       entity->Transform.Position.y,
-                       entity->Transform.Position.z),
-            JPH::Quat(q.x, q.y, q.z, q.w), JPH::EActivation::DontActivate);
-      }
+      Transform pose = registry.GetWorldPose(handle);
+      glm::quat q = glm::quat(glm::radians(pose.Rotation));
+      bodyInterface.SetPositionAndRotation(
+          body, JPH::RVec3(pose.Position.x, pose.Position.y, pose.Position.z),
+          JPH::Quat(q.x, q.y, q.z, q.w), JPH::EActivation::DontActivate);
     }
 
-    if (entity == selectedEntity) {
-      glEnable(GL_STENCIL_TEST);
-      glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-      glStencilFunc(GL_ALWAYS, 1, 0xFF);
-      glStencilMask(0xFF);
-    }
-    if (entity->Material.AlbedoMap)
-      entity->Material.AlbedoMap->Bind();
+    const auto &handles = registry.GetHandles();
+    for (size_t i = 0; i < handles.size(); i++)
+      m_RenderTransforms[i] = registry.GetWorldTransform(handles[i]);
+  }
 
-    if (entity->Mesh && entity->MaterialShader &&
-        entity->MaterialShader->IsValid()) {
-      Renderer::Submit(entity->MaterialShader, entity->Mesh,
-                       entity->Transform.GetTransform(),
-                       entity->Material.Tiling);
-    }
+  // Stream level assets in and out around both views before they draw
+  {
+    SimulationLock simLock(m_SimulationMutex);
+    m_LevelStreamer->Update(
+        {m_EditorCamera->GetPosition(), m_Camera->GetPosition()});
+  }
 
-    if (entity == selectedEntity)
-      glStencilMask(0x00);
+  ExtractRenderProxies(selectedEntity);
+
+  Renderer::BeginFrame((float)glfwGetTime());
+
+  // 1. Scene View Pass
+  m_SceneFramebuffer->Bind();
+  glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+  Renderer::BeginScene(*m_EditorCamera, m_Sun, m_SceneViewportSize);
+  m_Skybox->Draw();
+  const RenderProxy *selected = nullptr;
+  if (m_SelectedProxy != NO_PROXY && m_SceneVisible[m_SelectedProxy])
+    selected = &m_RenderProxies[m_SelectedProxy];
+
+  // The selection is drawn on its own first so its whole silhouette is
+  // marked in the stencil for the outline
+  if (selectedEntity) {
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    glStencilFunc(GL_ALWAYS, 1, 0xFF);
+    glStencilMask(0xFF);
+    if (selected) {
+      Renderer::Submit(selected->MaterialShader, selected->Mesh,
+                       selected->ProxyMaterial, selected->Transform);
+    }
+    Renderer::Flush();
+    glStencilMask(0x00);
   }
 
+  SubmitRenderProxies(m_SceneVisible, m_SelectedProxy, m_SceneCulling);
+  Renderer::Flush();
+
   if (selectedEntity) {
     glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
     glDisable(GL_DEPTH_TEST);
@@ -1999,10 +2563,11 @@ void Application::RenderFrame(float alpha) {
     m_OutlineShader->SetFloat3("u_Color", {1.0f, 0.5f, 0.0f});
     glLineWidth(4.0f);
     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    glm::mat4 transform =
-        glm::scale(selectedEntity->Transform.GetTransform(), glm::vec3(1.01f));
-    if (selectedEntity->Mesh)
-      Renderer::Submit(m_OutlineShader, selectedEntity->Mesh, transform);
+    if (selected) {
+      Renderer::Submit(m_OutlineShader, selected->Mesh,
+                       glm::scale(selected->Transform, glm::vec3(1.01f)));
+    }
+    Renderer::Flush();
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     glStencilMask(0xFF);
     glEnable(GL_DEPTH_TEST);
@@ -2015,21 +2580,9 @@ void Application::RenderFrame(float alpha) {
   m_GameFramebuffer->Bind();
   glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-  Renderer::BeginScene(*m_Camera, m_Sun);
-  m_Skybox->Draw(*m_Camera);
-  for (auto &entity : m_Scene->GetEntities()) {
-    if (entity->Name == "Player")
-      continue; // Hide Player in Game View
-    if (entity->Material.AlbedoMap)
-      entity->Material.AlbedoMap->Bind();
-
-    if (entity->Mesh && entity->MaterialShader &&
-        entity->MaterialShader->IsValid()) {
-      Renderer::Submit(entity->MaterialShader, entity->Mesh,
-                       entity->Transform.GetTransform(),
-                       entity->Material.Tiling);
-    }
-  }
+  Renderer::BeginScene(*m_Camera, m_Sun, m_GameViewportSize);
+  m_Skybox->Draw();
+  SubmitRenderProxies(m_GameVisible, m_PlayerProxy, m_GameCulling);
   Renderer::EndScene();
 
   // 3. HUD Rendering (only in game viewport)
@@ -2044,16 +2597,14 @@ void Application::RenderFrame(float alpha) {
       HUDRenderer::DrawString("FPS: " + std::to_string((int)m_GameFPS), pos, scale, {0, 1, 0, 1});
   }
 
-  if (m_Scene) {
-    if (auto entity = m_Scene->FindEntityByName("Player")) {
-      if (auto *pc = entity->GetScript<PlayerController>()) {
-        // 1 unit = 0.75 inches
-        // 1 meter = 52.4934 Hammer Units
-        constexpr float METERS_TO_HU = 52.4934f;
-        float speedHU = pc->GetSpeed() * METERS_TO_HU;
-        HUDRenderer::RenderSpeed(speedHU);
-      }
-    }
+  if (m_SceneState != SceneState::Edit) {
+    // 1 unit = 0.75 inches
+    // 1 meter = 52.4934 Hammer Units
+    constexpr float METERS_TO_HU = 52.4934f;
+    const glm::vec3 &velocity = m_RenderCurrent->player_velocity;
+    float speedHU =
+        glm::length(glm::vec2(velocity.x, velocity.z)) * METERS_TO_HU;
+    HUDRenderer::RenderSpeed(speedHU);
   }
 
   HUDRenderer::EndHUD();
@@ -2062,6 +2613,9 @@ void Application::RenderFrame(float alpha) {
 
   m_ImGuiLayer->Begin();
 
+  // Panels below read and edit entities directly
+  SimulationLock simLock(m_SimulationMutex);
+
   if (m_ResetLayoutOnNextFrame) {
     ResetLayout();
     m_ResetLayoutOnNextFrame = false;
@@ -2188,8 +2742,10 @@ void Application::RenderFrame(float alpha) {
           }
 
           if (mesh) {
-            auto entity = CreateRef<Entity>(name, mesh, m_DefaultShader,
-                                            m_DefaultTexture);
+            auto entity = m_Scene->CreateEntity(name);
+            entity->Mesh = mesh;
+            entity->MaterialShader = m_DefaultShader;
+            entity->Material.AlbedoMap = m_DefaultTexture;
             entity->MeshPath = meshPath;
             glm::vec3 spawnPos = m_EditorCamera->GetPosition() +
                                  m_EditorCamera->GetForward() * 5.0f;
@@ -2204,7 +2760,7 @@ void Application::RenderFrame(float alpha) {
                 entity->Anchored ? JPH::EMotionType::Static
                                  : JPH::EMotionType::Dynamic,
                 entity->Anchored ? Layers::NON_MOVING : Layers::MOVING);
-            settings.mUserData = (uint64_t)entity.get();
+            settings.mUserData = entity->GetHandle().ToUserData();
             entity->PhysicsBody = bodyInterface.CreateAndAddBody(
                 settings, JPH::EActivation::Activate);
 
@@ -2284,9 +2840,10 @@ void Application::RenderFrame(float alpha) {
                 mesh = MeshLoader::LoadSTL(assetPath.string());
 
               if (mesh) {
-                auto entity =
-                    CreateRef<Entity>(assetPath.stem().string(), mesh,
-                                      m_DefaultShader, m_DefaultTexture);
+                auto entity = m_Scene->CreateEntity(assetPath.stem().string());
+                entity->Mesh = mesh;
+                entity->MaterialShader = m_DefaultShader;
+                entity->Material.AlbedoMap = m_DefaultTexture;
                 entity->MeshPath = assetPath.string();
                 glm::vec3 dropPos = m_EditorCamera->GetPosition() +
                                     m_EditorCamera->GetForward() * 5.0f;
@@ -2299,10 +2856,41 @@ void Application::RenderFrame(float alpha) {
                     entity->Anchored ? JPH::EMotionType::Static
                                      : JPH::EMotionType::Dynamic,
                     entity->Anchored ? Layers::NON_MOVING : Layers::MOVING);
-                settings.mUserData = (uint64_t)entity.get();
+                settings.mUserData = entity->GetHandle().ToUserData();
                 entity->PhysicsBody = bodyInterface.CreateAndAddBody(
                     settings, JPH::EActivation::Activate);
 
+                m_Scene->AddEntity(entity);
+                m_SceneHierarchyPanel->SetSelectedEntity(entity);
+                m_SceneModified = true;
+              }
+            } else if (assetPath.extension() ==
+                       SceneSerializer::PREFAB_EXTENSION) {
+              SceneSerializer serializer(m_Scene.get(),
+                                         m_ProjectRoot.string());
+              if (auto entity =
+                      serializer.InstantiatePrefab(assetPath.string())) {
+                glm::vec3 dropPos = m_EditorCamera->GetPosition() +
+                                    m_EditorCamera->GetForward() * 5.0f;
+                entity->Transform.Position = dropPos;
+
+                if (entity->Collidable) {
+                  glm::quat q =
+                      glm::quat(glm::radians(entity->Transform.Rotation));
+                  JPH::BodyCreationSettings settings(
+                      PhysicsShapes::CreateBox({entity->Transform.Scale.x,
+                                                entity->Transform.Scale.y,
+                                                entity->Transform.Scale.z}),
+                      JPH::RVec3(dropPos.x, dropPos.y, dropPos.z),
+                      JPH::Quat(q.x, q.y, q.z, q.w),
+                      entity->Anchored ? JPH::EMotionType::Static
+                                       : JPH::EMotionType::Dynamic,
+                      entity->Anchored ? Layers::NON_MOVING : Layers::MOVING);
+                  settings.mUserData = entity->GetHandle().ToUserData();
+                  entity->PhysicsBody = bodyInterface.CreateAndAddBody(
+                      settings, JPH::EActivation::Activate);
+                }
+
                 m_Scene->AddEntity(entity);
                 m_SceneHierarchyPanel->SetSelectedEntity(entity);
                 m_SceneModified = true;
@@ -2325,8 +2913,16 @@ void Application::RenderFrame(float alpha) {
               m_EditorCamera->GetProjectionMatrix();
           glm::mat4 cameraView = m_EditorCamera->GetViewMatrix();
 
-          // Entity transform
-          glm::mat4 transform = selectedEntity->Transform.GetTransform();
+          // Entity transform, in world space; children are edited relative
+          // to their parent
+          EntityRegistry &registry = m_Scene->GetRegistry();
+          EntityHandle parent =
+              registry.GetParent(selectedEntity->GetHandle());
+          glm::mat4 parentWorld = parent.IsValid()
+                                      ? registry.ComputeWorldTransform(parent)
+                                      : glm::mat4(1.0f);
+          glm::mat4 transform =
+              parentWorld * selectedEntity->Transform.GetTransform();
 
           // Snapping
           bool snap = Input::IsKeyPressed(GLFW_KEY_LEFT_CONTROL) ||
@@ -2348,8 +2944,9 @@ void Application::RenderFrame(float alpha) {
               m_InitialGizmoTransform = selectedEntity->Transform;
             }
 
+            glm::mat4 local = glm::inverse(parentWorld) * transform;
             float translation[3], rotation[3], scale[3];
-            ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(transform),
+            ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(local),
                                                   translation, rotation, scale);
 
             selectedEntity->Transform.Position = {
@@ -2503,6 +3100,77 @@ void Application::RenderFrame(float alpha) {
       ImGui::Text("Velocity:  X: %.2f  Y: %.2f  Z: %.2f", vel.x * METERS_TO_HU,
                   vel.y * METERS_TO_HU, vel.z * METERS_TO_HU);
       ImGui::Text("Speed (H): %.2f units/s", speed * METERS_TO_HU);
+
+      ImGui::Separator();
+      const Renderer::Statistics &render = Renderer::GetStatistics();
+      ImGui::Text("Draw calls: %u (%u objects)", render.DrawCalls,
+                  render.Instances);
+      ImGui::Text("Binds: %u shader  %u texture  %u mesh",
+                  render.ShaderBinds, render.TextureBinds,
+                  render.VertexArrayBinds);
+      ImGui::Text("Visible: %u scene  %u game  (culled %u / %u)",
+                  m_SceneCulling.Visible, m_GameCulling.Visible,
+                  m_SceneCulling.Culled, m_GameCulling.Culled);
+      const StaticGeometry::Statistics &batches =
+          m_StaticGeometry.GetStatistics();
+      ImGui::Text("Static batches: %u (%u entities, %u evicted, %u cells "
+                  "pending)",
+                  batches.Batches, batches.Merged, batches.Evicted,
+                  batches.DirtyCells);
+      HUDRenderer::Statistics hud = HUDRenderer::GetStatistics();
+      ImGui::Text("HUD: %u quads in %u draws", hud.Quads, hud.DrawCalls);
+      TextureCache::Statistics textures = TextureCache::GetStatistics();
+      ImGui::Text("Textures: %u resident (%.1f MB), %u hits / %u misses",
+                  textures.Resident,
+                  textures.ResidentBytes / (1024.0f * 1024.0f), textures.Hits,
+                  textures.Misses);
+
+      ImGui::Separator();
+      TickStats::Summary ticks = m_TickStats.Summarize();
+      ImGui::Text("Tick Health (last %zu frames)", ticks.Samples);
+      if (ImGui::BeginTable("TickHealthTable", 5,
+                            ImGuiTableFlags_RowBg |
+                                ImGuiTableFlags_SizingStretchProp)) {
+        ImGui::TableSetupColumn("");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+
+        auto row = [](const char *label, const TickStats::Percentiles &p,
+                      const char *format, float scale) {
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(label);
+          for (float value : {p.P50, p.P95, p.P99, p.Max}) {
+            ImGui::TableNextColumn();
+            ImGui::Text(format, value * scale);
+          }
+        };
+        row("Ticks/frame", ticks.Ticks, "%.0f", 1.0f);
+        row("Late ticks", ticks.LateTicks, "%.0f", 1.0f);
+        row("Tick ms", ticks.TickTime, "%.2f", 1000.0f);
+        row("Residue ms", ticks.AccumulatorResidue, "%.2f", 1000.0f);
+        row("Clamped ms", ticks.ClampedTime, "%.1f", 1000.0f);
+        row("Budget drop ms", ticks.BudgetDropped, "%.1f", 1000.0f);
+        ImGui::EndTable();
+      }
+      ImGui::Text("Dropped: %.1f ms frame clamp, %.1f ms tick budget",
+                  ticks.TotalClampedTime * 1000.0,
+                  ticks.TotalBudgetDropped * 1000.0);
+
+      if (m_FramePacer.GetTargetRate() > 0) {
+        ImGui::Separator();
+        FramePacer::Stats pacing = m_FramePacer.GetStats();
+        ImGui::Text("Frame Pacing (%d FPS cap)", m_FramePacer.GetTargetRate());
+        ImGui::Text("Wake late: p50 %.0f us  p99 %.0f us  max %.0f us",
+                    pacing.WakeErrorP50Us, pacing.WakeErrorP99Us,
+                    pacing.WakeErrorMaxUs);
+        ImGui::Text("Sleep slack: %.0f us  Spin: %.0f us/frame  Overruns: %llu",
+                    pacing.SlackUs, pacing.SpinUs,
+                    (unsigned long long)pacing.OverrunFrames);
+      }
       ImGui::End();
     } else {
       ImGui::SetNextWindowSizeConstraints(ImVec2(200, 100),
@@ -2624,6 +3292,7 @@ void Application::RenderFrame(float alpha) {
     }
   }
 
+  simLock.unlock();
   m_ImGuiLayer->End();
 }
 
@@ -1,5 +1,8 @@
 #include "Base.h"
+#include "Core/FramePacer.h"
 #include "Core/GameState.h"
+#include "Core/TickStats.h"
+#include "Core/TripleBuffer.h"
 #include "Core/UndoSystem.h"
 #include "Events/WindowEvent.h"
 #include "ImGui/ImGuiLayer.h"
@@ -9,16 +12,24 @@
 #include "Renderer/Camera.h"
 #include "Renderer/CameraController.h"
 #include "Renderer/Framebuffer.h"
+#include "Renderer/FrustumCuller.h"
 #include "Renderer/HUDRenderer.h"
+#include "Renderer/LevelStreamer.h"
 #include "Renderer/Light.h"
 #include "Renderer/Scene.h"
 #include "Renderer/Shader.h"
 #include "Renderer/Skybox.h"
+#include "Renderer/StaticGeometry.h"
 #include "Renderer/Texture.h"
 #include "Renderer/VertexArray.h"
 #include "Window.h"
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <glad/glad.h>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace S67 {
 
@@ -29,9 +40,18 @@ enum class SceneState { Edit = 0, Play = 1, Pause = 2 };
 
 enum class EditorTheme { Unity = 0, Dracula = 1, Classic = 2, Light = 3 };
 
+// Dedicated simulation mode: no window, GL context, ImGui or HUD. The level is
+// loaded straight into Play and only the fixed tick loop runs.
+struct HeadlessSpecification {
+  bool Enabled = false;
+  uint64_t TickCount = 0; // 0 = run until interrupted
+  bool RealTime = false;  // false = run ticks back to back as fast as possible
+};
+
 class Application {
 public:
-  Application(const std::string &executablePath, const std::string &arg = "");
+  Application(const std::string &executablePath, const std::string &arg = "",
+              const HeadlessSpecification &headless = {});
   virtual ~Application();
 
   void Run();
@@ -77,11 +97,17 @@ public:
   void RenderFrame(float alpha);
 
   inline Window &GetWindow() { return *m_Window; }
+  bool IsHeadless() const { return m_Headless.Enabled; }
   ImGuiLayer &GetImGuiLayer() { return *m_ImGuiLayer; }
   inline static Application &Get() { return *s_Instance; }
 
   Ref<PerspectiveCamera> GetCamera() { return m_Camera; }
+  // Driven by PlayerController on the simulation side; the game view camera
+  // is interpolated from GameState instead of reading this directly.
+  Ref<PerspectiveCamera> GetPlayerCamera() { return m_PlayerCamera; }
+  TickStats &GetTickStats() { return m_TickStats; }
   Scene &GetScene() { return *m_Scene; }
+  LevelStreamer &GetLevelStreamer() { return *m_LevelStreamer; }
 
   const std::filesystem::path &GetProjectRoot() const { return m_ProjectRoot; }
   void SetProjectRoot(const std::filesystem::path &root);
@@ -109,8 +135,28 @@ private:
   void AddToRecentProjects(const std::string &path);
   void InitDefaultAssets();
 
+  void RunHeadless();
+
+  // Simulation thread (host_thread_mode 1)
+  using SimulationLock = std::unique_lock<std::recursive_timed_mutex>;
+  int AdvanceSimulation(double frame_time);
+  void CaptureEntityStates(EntitySnapshot &snapshot);
+  void StartSimulationThread();
+  void StopSimulationThread();
+  void SimulationThreadMain();
+
+  // Per-frame render extraction, shared by the Scene and Game views
+  struct CullingStats {
+    uint32_t Visible = 0;
+    uint32_t Culled = 0;
+  };
+  void ExtractRenderProxies(const Ref<Entity> &selectedEntity);
+  void SubmitRenderProxies(const std::vector<uint8_t> &visible, size_t skip,
+                           CullingStats &stats);
+
   std::unique_ptr<Window> m_Window;
   bool m_Running = true;
+  HeadlessSpecification m_Headless;
 
   // Tick System Constants
   float m_TickRate = 66.0f;
@@ -124,12 +170,54 @@ private:
   double m_Accumulator = 0.0;
   double m_PreviousFrameTime = 0.0;
   uint64_t m_TickNumber = 0;
+  TickStats m_TickStats;
+
+  // Simulation thread. It holds m_SimulationMutex for each batch of ticks;
+  // the main thread holds it while it reads or edits mutable scene state.
+  std::thread m_SimulationThread;
+  std::atomic<bool> m_SimulationRunning{false};
+  std::recursive_timed_mutex m_SimulationMutex;
+  TripleBuffer<GameStateSnapshot> m_Snapshots;
+
+  // States RenderFrame interpolates between (main loop or latest snapshot)
+  const GameState *m_RenderPrevious = &m_PreviousState;
+  const GameState *m_RenderCurrent = &m_CurrentState;
+  EntitySnapshot m_RenderEntities; // Blended scratch, reused every frame
+  std::vector<glm::mat4> m_RenderTransforms;
+  std::vector<EntityHandle> m_ChangedTransforms; // Edit-mode scratch
+
+  // Everything either view may draw this frame, built once by
+  // ExtractRenderProxies() from the entities with a drawable mesh. The culler
+  // holds the proxies' world bounds in the same order.
+  struct RenderProxy {
+    glm::mat4 Transform;
+    AABB Bounds; // World space
+    Ref<VertexArray> Mesh;
+    Ref<Shader> MaterialShader;
+    Material ProxyMaterial; // Albedo and tiling only
+    bool Batched = false; // Drawn by a static batch; here as the selection
+  };
+  static constexpr size_t NO_PROXY = SIZE_MAX;
+  std::vector<RenderProxy> m_RenderProxies;
+  size_t m_SelectedProxy = NO_PROXY;
+  size_t m_PlayerProxy = NO_PROXY; // Hidden in the Game view
+  FrustumCuller m_Culler;
+  std::vector<uint8_t> m_SceneVisible;
+  std::vector<uint8_t> m_GameVisible;
+  CullingStats m_SceneCulling;
+  CullingStats m_GameCulling;
+  StaticGeometry m_StaticGeometry;
+  bool m_StaticGeometryPending = false; // Rebuilt by the next frame
 
   Ref<PerspectiveCamera> m_Camera; // Game Camera
+  Ref<PerspectiveCamera> m_PlayerCamera;
+  // Game view aspect ratio, for the player camera's projection
+  std::atomic<float> m_GameAspect{1280.0f / 720.0f};
   Ref<PerspectiveCamera> m_EditorCamera;
   Ref<CameraController> m_CameraController; // Game Camera Controller
   Ref<CameraController> m_EditorCameraController;
   Scope<Scene> m_Scene;
+  Scope<LevelStreamer> m_LevelStreamer;
   DirectionalLight m_Sun;
 
   float m_LastFrameTime = 0.0f;
@@ -176,6 +264,7 @@ private:
   glm::vec4 m_CustomColor = {0.1f, 0.105f, 0.11f, 1.0f};
   EditorTheme m_EditorTheme = EditorTheme::Dracula;
   int m_FPSCap = 0; // 0 = Unlimited
+  FramePacer m_FramePacer;
   bool m_VSync = true;
   std::filesystem::path m_EngineAssetsRoot;
 
@@ -195,7 +284,7 @@ private:
   Ref<VertexArray> m_CubeMesh;
   Ref<Shader> m_HUDShader;
 
-  SceneState m_SceneState = SceneState::Edit;
+  std::atomic<SceneState> m_SceneState{SceneState::Edit};
   bool m_CursorLocked = false;
 
   // Save notification
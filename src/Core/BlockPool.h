@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Core/Base.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace S67 {
+
+/**
+ * @brief Free-list pool of equally sized blocks
+ *
+ * Blocks are carved out of slabs of BLOCKS_PER_SLAB, one heap allocation per
+ * slab, and freed blocks go on an intrusive free list. When the last live
+ * block is returned (a cleared scene), the pool rewinds: the free list is
+ * dropped and the slabs are handed out again front to back, so reloading a
+ * level neither calls malloc nor scatters its entities across memory.
+ *
+ * The block size is fixed by the first Allocate(); later requests that do
+ * not fit return nullptr so the caller can fall back to the heap. Not thread
+ * safe; used under the same rules as the EntityRegistry it serves.
+ */
+class BlockPool {
+public:
+  static constexpr size_t BLOCKS_PER_SLAB = 256;
+
+  BlockPool() = default;
+  BlockPool(const BlockPool &) = delete;
+  BlockPool &operator=(const BlockPool &) = delete;
+
+  // Whether Allocate() would serve this request; always true before the
+  // block size is fixed
+  bool Fits(size_t size, size_t alignment) const {
+    return m_BlockSize == 0 ||
+           (size <= m_BlockSize && alignment <= m_BlockAlign);
+  }
+
+  void *Allocate(size_t size, size_t alignment) {
+    if (m_BlockSize == 0) {
+      m_BlockAlign = std::max(alignment, alignof(FreeBlock));
+      m_BlockSize = (std::max(size, sizeof(FreeBlock)) + m_BlockAlign - 1) /
+                    m_BlockAlign * m_BlockAlign;
+    }
+    if (!Fits(size, alignment))
+      return nullptr;
+
+    m_LiveBlocks++;
+    if (m_FreeList) {
+      FreeBlock *block = m_FreeList;
+      m_FreeList = block->Next;
+      return block;
+    }
+
+    // Bump through the slabs
+    if (m_SlabCursor == BLOCKS_PER_SLAB) {
+      m_CurrentSlab++;
+      m_SlabCursor = 0;
+    }
+    if (m_CurrentSlab == m_Slabs.size()) {
+      void *slab = ::operator new(m_BlockSize * BLOCKS_PER_SLAB,
+                                  std::align_val_t(m_BlockAlign));
+      m_Slabs.emplace_back(static_cast<std::byte *>(slab),
+                           SlabDeleter{m_BlockAlign});
+    }
+    return m_Slabs[m_CurrentSlab].get() + m_BlockSize * m_SlabCursor++;
+  }
+
+  void Deallocate(void *pointer) {
+    FreeBlock *block = new (pointer) FreeBlock{m_FreeList};
+    m_FreeList = block;
+    if (--m_LiveBlocks == 0) {
+      m_FreeList = nullptr;
+      m_CurrentSlab = 0;
+      m_SlabCursor = 0;
+    }
+  }
+
+  size_t GetLiveBlocks() const { return m_LiveBlocks; }
+  size_t GetCapacity() const { return m_Slabs.size() * BLOCKS_PER_SLAB; }
+
+private:
+  struct FreeBlock {
+    FreeBlock *Next;
+  };
+  struct SlabDeleter {
+    size_t Alignment;
+    void operator()(std::byte *slab) const {
+      ::operator delete(slab, std::align_val_t(Alignment));
+    }
+  };
+  using Slab = std::unique_ptr<std::byte[], SlabDeleter>;
+
+  std::vector<Slab> m_Slabs;
+  size_t m_CurrentSlab = 0;
+  size_t m_SlabCursor = 0;
+  FreeBlock *m_FreeList = nullptr;
+  size_t m_LiveBlocks = 0;
+  size_t m_BlockSize = 0;
+  size_t m_BlockAlign = 0;
+};
+
+/**
+ * @brief Standard allocator over a shared BlockPool
+ *
+ * Meant for std::allocate_shared, which makes one allocation holding both the
+ * control block and the object. Every copy shares ownership of the pool, so
+ * it outlives the last object allocated from it.
+ */
+template <typename T> class PoolAllocator {
+public:
+  using value_type = T;
+
+  explicit PoolAllocator(Ref<BlockPool> pool) : m_Pool(std::move(pool)) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) : m_Pool(other.m_Pool) {}
+
+  T *allocate(size_t count) {
+    if (count == 1 && m_Pool->Fits(sizeof(T), alignof(T)))
+      return static_cast<T *>(m_Pool->Allocate(sizeof(T), alignof(T)));
+    return std::allocator<T>().allocate(count);
+  }
+
+  void deallocate(T *pointer, size_t count) {
+    if (count == 1 && m_Pool->Fits(sizeof(T), alignof(T)))
+      m_Pool->Deallocate(pointer);
+    else
+      std::allocator<T>().deallocate(pointer, count);
+  }
+
+  template <typename U> bool operator==(const PoolAllocator<U> &other) const {
+    return m_Pool == other.m_Pool;
+  }
+  template <typename U> bool operator!=(const PoolAllocator<U> &other) const {
+    return m_Pool != other.m_Pool;
+  }
+
+private:
+  template <typename U> friend class PoolAllocator;
+
+  Ref<BlockPool> m_Pool;
+};
+
+} // namespace S67
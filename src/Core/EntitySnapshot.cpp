@@ -0,0 +1,131 @@
+#include "EntitySnapshot.h"
+
+#include <cmath>
+
+namespace S67 {
+
+void EntitySnapshot::Resize(size_t count) {
+  Handles.resize(count);
+  PositionX.resize(count);
+  PositionY.resize(count);
+  PositionZ.resize(count);
+  RotationX.resize(count);
+  RotationY.resize(count);
+  RotationZ.resize(count);
+  RotationW.resize(count);
+  ScaleX.resize(count);
+  ScaleY.resize(count);
+  ScaleZ.resize(count);
+}
+
+void EntitySnapshot::Set(size_t index, EntityHandle handle,
+                         const glm::vec3 &position, const glm::quat &rotation,
+                         const glm::vec3 &scale) {
+  Handles[index] = handle;
+  PositionX[index] = position.x;
+  PositionY[index] = position.y;
+  PositionZ[index] = position.z;
+  RotationX[index] = rotation.x;
+  RotationY[index] = rotation.y;
+  RotationZ[index] = rotation.z;
+  RotationW[index] = rotation.w;
+  ScaleX[index] = scale.x;
+  ScaleY[index] = scale.y;
+  ScaleZ[index] = scale.z;
+}
+
+glm::quat EntitySnapshot::RotationFromEuler(const glm::vec3 &eulerDegrees) {
+  glm::vec3 radians = glm::radians(eulerDegrees);
+  return glm::angleAxis(radians.x, glm::vec3(1.0f, 0.0f, 0.0f)) *
+         glm::angleAxis(radians.y, glm::vec3(0.0f, 1.0f, 0.0f)) *
+         glm::angleAxis(radians.z, glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+static void LerpArray(const float *__restrict from, const float *__restrict to,
+                      float alpha, float *__restrict out, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    out[i] = from[i] + (to[i] - from[i]) * alpha;
+}
+
+void EntitySnapshot::Interpolate(const EntitySnapshot &from,
+                                 const EntitySnapshot &to, float alpha,
+                                 EntitySnapshot &out) {
+  const size_t count = to.Size();
+  out.Resize(count);
+  out.Handles = to.Handles;
+
+  // A slot changed owner since the previous tick: nothing to blend from
+  const EntitySnapshot &start = from.HasSameLayout(to) ? from : to;
+
+  LerpArray(start.PositionX.data(), to.PositionX.data(), alpha,
+            out.PositionX.data(), count);
+  LerpArray(start.PositionY.data(), to.PositionY.data(), alpha,
+            out.PositionY.data(), count);
+  LerpArray(start.PositionZ.data(), to.PositionZ.data(), alpha,
+            out.PositionZ.data(), count);
+  LerpArray(start.ScaleX.data(), to.ScaleX.data(), alpha, out.ScaleX.data(),
+            count);
+  LerpArray(start.ScaleY.data(), to.ScaleY.data(), alpha, out.ScaleY.data(),
+            count);
+  LerpArray(start.ScaleZ.data(), to.ScaleZ.data(), alpha, out.ScaleZ.data(),
+            count);
+
+  // Normalised lerp: branch-free and within a fraction of a degree of slerp
+  // for the small per-tick rotations being blended here
+  const float *__restrict ax = start.RotationX.data();
+  const float *__restrict ay = start.RotationY.data();
+  const float *__restrict az = start.RotationZ.data();
+  const float *__restrict aw = start.RotationW.data();
+  const float *__restrict bx = to.RotationX.data();
+  const float *__restrict by = to.RotationY.data();
+  const float *__restrict bz = to.RotationZ.data();
+  const float *__restrict bw = to.RotationW.data();
+  float *__restrict ox = out.RotationX.data();
+  float *__restrict oy = out.RotationY.data();
+  float *__restrict oz = out.RotationZ.data();
+  float *__restrict ow = out.RotationW.data();
+
+  const float inverseAlpha = 1.0f - alpha;
+  for (size_t i = 0; i < count; i++) {
+    float dot = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+    float weight = dot < 0.0f ? -alpha : alpha; // Take the short way round
+    float x = ax[i] * inverseAlpha + bx[i] * weight;
+    float y = ay[i] * inverseAlpha + by[i] * weight;
+    float z = az[i] * inverseAlpha + bz[i] * weight;
+    float w = aw[i] * inverseAlpha + bw[i] * weight;
+    float invLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+    ox[i] = x * invLength;
+    oy[i] = y * invLength;
+    oz[i] = z * invLength;
+    ow[i] = w * invLength;
+  }
+}
+
+void EntitySnapshot::BuildTransforms(const EntitySnapshot &snapshot,
+                                     std::vector<glm::mat4> &outTransforms) {
+  const size_t count = snapshot.Size();
+  outTransforms.resize(count);
+
+  for (size_t i = 0; i < count; i++) {
+    float x = snapshot.RotationX[i], y = snapshot.RotationY[i],
+          z = snapshot.RotationZ[i], w = snapshot.RotationW[i];
+    float xx = x * x, yy = y * y, zz = z * z;
+    float xy = x * y, xz = x * z, yz = y * z;
+    float wx = w * x, wy = w * y, wz = w * z;
+    float sx = snapshot.ScaleX[i], sy = snapshot.ScaleY[i],
+          sz = snapshot.ScaleZ[i];
+
+    // translate * mat4_cast(rotation) * scale, written column by column
+    glm::mat4 &m = outTransforms[i];
+    m[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx,
+                     2.0f * (xz - wy) * sx, 0.0f);
+    m[1] = glm::vec4(2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy,
+                     2.0f * (yz + wx) * sy, 0.0f);
+    m[2] = glm::vec4(2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz,
+                     (1.0f - 2.0f * (xx + yy)) * sz, 0.0f);
+    m[3] = glm::vec4(snapshot.PositionX[i], snapshot.PositionY[i],
+                     snapshot.PositionZ[i], 1.0f);
+  }
+}
+
+} // namespace S67
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Renderer/EntityHandle.h"
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+
+namespace S67 {
+
+/**
+ * @brief Structure-of-arrays transform snapshot of every scene entity
+ *
+ * Captured once per tick in Application::UpdateGameTick and blended in bulk at
+ * render time. Each component lives in its own contiguous float array so the
+ * per-frame blend loops vectorise. Slot i is Scene::GetEntities()[i] at
+ * capture time and Handles[i] its handle, which the render thread only
+ * compares and never resolves.
+ *
+ * Rotations are unit quaternions in the X*Y*Z order Transform::GetTransform()
+ * uses, so blending and GetTransform() agree for unmoving entities.
+ */
+struct EntitySnapshot {
+  std::vector<EntityHandle> Handles;
+  std::vector<float> PositionX, PositionY, PositionZ;
+  std::vector<float> RotationX, RotationY, RotationZ, RotationW;
+  std::vector<float> ScaleX, ScaleY, ScaleZ;
+
+  size_t Size() const { return Handles.size(); }
+  void Resize(size_t count);
+  void Set(size_t index, EntityHandle handle, const glm::vec3 &position,
+           const glm::quat &rotation, const glm::vec3 &scale);
+
+  // Same entities in the same slots, so slots can be blended pairwise
+  bool HasSameLayout(const EntitySnapshot &other) const {
+    return Handles == other.Handles;
+  }
+
+  static glm::quat RotationFromEuler(const glm::vec3 &eulerDegrees);
+
+  // Blends from -> to by alpha into out (lerp positions/scales, shortest-arc
+  // nlerp rotations). If the layouts differ, out is a copy of to.
+  static void Interpolate(const EntitySnapshot &from, const EntitySnapshot &to,
+                          float alpha, EntitySnapshot &out);
+
+  // One world matrix per slot, equivalent to Transform::GetTransform()
+  static void BuildTransforms(const EntitySnapshot &snapshot,
+                              std::vector<glm::mat4> &outTransforms);
+};
+
+} // namespace S67
@@ -0,0 +1,172 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <time.h>
+#elif defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002 // Older SDKs
+#endif
+#endif
+
+namespace S67 {
+
+using namespace std::chrono;
+
+// Spin at least this long so an ordinary wake-up never lands late
+static constexpr nanoseconds MIN_SPIN = microseconds(200);
+#ifdef __linux__
+// clock_nanosleep wakes within microseconds, so anything past this (or a
+// quarter of the period) is a one-off stall, and must not turn the limiter
+// into a spinner
+static constexpr nanoseconds MAX_SPIN = milliseconds(2);
+#endif
+
+void FramePacer::SetTargetRate(int fps) {
+  fps = std::max(fps, 0);
+  if (fps == m_TargetRate)
+    return;
+
+  m_TargetRate = fps;
+  m_Period = fps > 0 ? duration_cast<Clock::duration>(duration<double>(1.0 / fps))
+                     : Clock::duration::zero();
+  Reset();
+}
+
+void FramePacer::Reset() {
+  m_HasDeadline = false;
+  m_Slack = INITIAL_SLACK;
+  m_Next = 0;
+  m_Count = 0;
+  m_TotalSpinUs = 0.0;
+  m_PacedFrames = 0;
+  m_OverrunFrames = 0;
+}
+
+void FramePacer::SleepUntil(Clock::time_point wakeTime) {
+#ifdef __linux__
+  // libstdc++/libc++ steady_clock is CLOCK_MONOTONIC, so the deadline can be
+  // handed to the kernel as an absolute time and EINTR simply retries
+  nanoseconds sinceEpoch = wakeTime.time_since_epoch();
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(duration_cast<seconds>(sinceEpoch).count());
+  ts.tv_nsec = static_cast<long>((sinceEpoch % seconds(1)).count());
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+  }
+#elif defined(_WIN32)
+  // Plain sleeps wake on the ~15.6 ms system tick. A high resolution
+  // waitable timer (Windows 10 1803+) does not; without one the slack
+  // tracking below absorbs the tick by spinning.
+  static HANDLE timer = CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+      TIMER_ALL_ACCESS);
+  nanoseconds remaining = wakeTime - Clock::now();
+  if (!timer || remaining <= nanoseconds::zero()) {
+    std::this_thread::sleep_until(wakeTime);
+    return;
+  }
+  LARGE_INTEGER due;
+  due.QuadPart = -static_cast<LONGLONG>(remaining.count() / 100); // Relative
+  if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE))
+    WaitForSingleObject(timer, INFINITE);
+  else
+    std::this_thread::sleep_until(wakeTime);
+#else
+  std::this_thread::sleep_until(wakeTime);
+#endif
+}
+
+// Jumps straight up to a new worst case and decays slowly back down once
+// things are quiet again. Called every frame, with zero when there was no
+// sleep to measure, so one bad wake-up can't keep the margin up for good.
+void FramePacer::TrackSlack(nanoseconds overshoot) {
+  if (overshoot > m_Slack)
+    m_Slack = overshoot;
+  else
+    m_Slack -= (m_Slack - overshoot) / 32;
+}
+
+void FramePacer::Wait() {
+  if (m_TargetRate <= 0)
+    return;
+
+  Clock::time_point now = Clock::now();
+  if (!m_HasDeadline) {
+    m_Deadline = now + m_Period;
+    m_HasDeadline = true;
+  } else {
+    m_Deadline += m_Period;
+  }
+
+  if (m_Deadline <= now) {
+    // Missed it. Within a frame we still try to hold cadence; further behind
+    // than that, start a fresh schedule instead of rushing frames out
+    m_OverrunFrames++;
+    if (now - m_Deadline > m_Period)
+      m_Deadline = now;
+    TrackSlack(nanoseconds::zero());
+    return;
+  }
+
+  // 1. Kernel sleep until the measured slack before the deadline
+#ifdef __linux__
+  nanoseconds maxSpin =
+      std::max(MIN_SPIN, std::min(MAX_SPIN, nanoseconds(m_Period / 4)));
+#else
+  // A coarse timer's overshoot is real, not a stall: spin through as much of
+  // it as the period allows rather than oversleeping every frame
+  nanoseconds maxSpin = std::max(MIN_SPIN, nanoseconds(m_Period));
+#endif
+  nanoseconds spinMargin = std::clamp(m_Slack + m_Slack / 4, MIN_SPIN, maxSpin);
+  Clock::time_point sleepUntil = m_Deadline - spinMargin;
+  nanoseconds overshoot = nanoseconds::zero();
+  if (sleepUntil > now) {
+    SleepUntil(sleepUntil);
+    // How late the scheduler woke us
+    overshoot = std::max(nanoseconds::zero(),
+                         duration_cast<nanoseconds>(Clock::now() - sleepUntil));
+  }
+  TrackSlack(overshoot);
+
+  // 2. Yield-spin through the last stretch. Yielding rather than pure
+  // spinning lets physics worker threads have the core if they want it.
+  Clock::time_point spinStart = Clock::now();
+  Clock::time_point woke = spinStart;
+  while (woke < m_Deadline) {
+    std::this_thread::yield();
+    woke = Clock::now();
+  }
+
+  m_TotalSpinUs += duration<double, std::micro>(woke - spinStart).count();
+  m_PacedFrames++;
+  m_WakeErrorsUs[m_Next] = duration<float, std::micro>(woke - m_Deadline).count();
+  m_Next = (m_Next + 1) % HISTORY;
+  m_Count = std::min(m_Count + 1, HISTORY);
+}
+
+FramePacer::Stats FramePacer::GetStats() const {
+  Stats stats;
+  stats.Samples = m_Count;
+  stats.SlackUs = duration<float, std::micro>(m_Slack).count();
+  stats.OverrunFrames = m_OverrunFrames;
+  if (m_PacedFrames > 0)
+    stats.SpinUs = static_cast<float>(m_TotalSpinUs / m_PacedFrames);
+  if (m_Count == 0)
+    return stats;
+
+  std::array<float, HISTORY> sorted = m_WakeErrorsUs;
+  std::sort(sorted.begin(), sorted.begin() + m_Count);
+  stats.WakeErrorP50Us = sorted[(m_Count - 1) / 2];
+  stats.WakeErrorP99Us = sorted[(m_Count - 1) * 99 / 100];
+  stats.WakeErrorMaxUs = sorted[m_Count - 1];
+  return stats;
+}
+
+} // namespace S67
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace S67 {
+
+/**
+ * @brief Frame rate limiter that sleeps instead of spinning
+ *
+ * Frames are paced against absolute deadlines (one period after the previous
+ * deadline), so a late wake does not push every following frame back. Wait()
+ * sleeps in the kernel until just before the deadline and only yields-spins
+ * through the final stretch. That stretch is sized from the scheduler slack
+ * actually measured on this machine, so it is a few hundred microseconds on
+ * Linux rather than the fixed 20 ms margin a coarse Windows timer needs.
+ * Windows sleeps on a high resolution waitable timer where there is one.
+ * On Linux the stretch is capped at 2 ms or a quarter of the period, so even
+ * a badly overslept frame leaves the next ones sleeping; elsewhere it may
+ * grow to the period, since a coarse timer oversleeps every time.
+ *
+ * Main thread only.
+ */
+class FramePacer {
+public:
+  struct Stats {
+    size_t Samples = 0;          // Paced frames in the window below
+    float WakeErrorP50Us = 0.0f; // How late Wait() returned vs the deadline
+    float WakeErrorP99Us = 0.0f;
+    float WakeErrorMaxUs = 0.0f;
+    float SlackUs = 0.0f;        // Current kernel sleep overshoot estimate
+    float SpinUs = 0.0f;         // Mean time spent spinning per frame
+    uint64_t OverrunFrames = 0;  // Frames that missed their deadline outright
+  };
+
+  // 0 = unlimited
+  void SetTargetRate(int fps);
+  int GetTargetRate() const { return m_TargetRate; }
+
+  // Call once per frame, after presenting
+  void Wait();
+  void Reset();
+
+  Stats GetStats() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void SleepUntil(Clock::time_point wakeTime);
+  void TrackSlack(std::chrono::nanoseconds overshoot);
+
+  static constexpr size_t HISTORY = 256;
+
+  int m_TargetRate = 0;
+  Clock::duration m_Period{};
+  Clock::time_point m_Deadline{};
+  bool m_HasDeadline = false;
+
+  static constexpr std::chrono::nanoseconds INITIAL_SLACK =
+      std::chrono::microseconds(200);
+  std::chrono::nanoseconds m_Slack = INITIAL_SLACK;
+
+  std::array<float, HISTORY> m_WakeErrorsUs{};
+  size_t m_Next = 0;
+  size_t m_Count = 0;
+  double m_TotalSpinUs = 0.0;
+  uint64_t m_PacedFrames = 0;
+  uint64_t m_OverrunFrames = 0;
+};
+
+} // namespace S67
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "EntitySnapshot.h"
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace S67 {
@@ -35,9 +37,23 @@ struct GameState {
     // Camera/eye height
     float eye_height = 1.7f;
 
-    // Entity states (for interpolation)
-    // TODO: If using full ECS, store entity list here
-    // std::vector<EntityState> entities;
+    // Entity transforms (for interpolation), in Scene::GetEntities() order
+    EntitySnapshot entities;
+};
+
+/**
+ * @brief Immutable hand-off from the simulation thread to the render thread
+ *
+ * Carries both tick states the renderer interpolates between, plus the
+ * accumulator residue and the clock time it was measured at, so the render
+ * thread can derive the same alpha the single-threaded loop would use.
+ */
+struct GameStateSnapshot {
+    GameState previous;
+    GameState current;
+    double accumulator = 0.0;  // Unconsumed time after the last tick
+    double timestamp = 0.0;    // glfwGetTime() when accumulator was sampled
+    uint64_t tick_number = 0;
 };
 
 } // namespace S67
@@ -1,22 +1,64 @@
 #include "Input.h"
 #include "Application.h"
 #include <GLFW/glfw3.h>
+#include <array>
+#include <mutex>
+#include <thread>
 
 namespace S67 {
 
+    // GLFW input may only be queried from the main thread. Other threads (the
+    // simulation thread) read the copy taken by SampleState() once per frame.
+    struct SampledInput {
+        std::array<bool, GLFW_KEY_LAST + 1> Keys{};
+        std::array<bool, GLFW_MOUSE_BUTTON_LAST + 1> MouseButtons{};
+        float MouseX = 0.0f, MouseY = 0.0f;
+    };
+
+    static const std::thread::id s_MainThreadID = std::this_thread::get_id();
+    static std::mutex s_SampleMutex;
+    static SampledInput s_Sampled;
+
+    static bool IsMainThread() {
+        return std::this_thread::get_id() == s_MainThreadID;
+    }
+
+    // Headless runs have no window to poll; report everything as released.
     bool Input::IsKeyPressed(int keycode) {
+        if (Application::Get().IsHeadless())
+            return false;
+        if (!IsMainThread()) {
+            if (keycode < 0 || keycode > GLFW_KEY_LAST)
+                return false;
+            std::lock_guard<std::mutex> lock(s_SampleMutex);
+            return s_Sampled.Keys[keycode];
+        }
         auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
         auto state = glfwGetKey(window, keycode);
         return state == GLFW_PRESS || state == GLFW_REPEAT;
     }
 
     bool Input::IsMouseButtonPressed(int button) {
+        if (Application::Get().IsHeadless())
+            return false;
+        if (!IsMainThread()) {
+            if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST)
+                return false;
+            std::lock_guard<std::mutex> lock(s_SampleMutex);
+            return s_Sampled.MouseButtons[button];
+        }
         auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
         auto state = glfwGetMouseButton(window, button);
         return state == GLFW_PRESS;
     }
 
     std::pair<float, float> Input::GetMousePosition() {
+        if (Application::Get().IsHeadless())
+            return { 0.0f, 0.0f };
+        if (!IsMainThread()) {
+            std::lock_guard<std::mutex> lock(s_SampleMutex);
+            return { s_Sampled.MouseX, s_Sampled.MouseY };
+        }
         auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
         double xpos, ypos;
         glfwGetCursorPos(window, &xpos, &ypos);
@@ -33,4 +75,27 @@ namespace S67 {
         return y;
     }
 
+    void Input::SampleState() {
+        if (Application::Get().IsHeadless())
+            return;
+
+        auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+        SampledInput sample;
+        // GLFW key codes are sparse; the first valid one is GLFW_KEY_SPACE
+        for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; key++) {
+            int state = glfwGetKey(window, key);
+            sample.Keys[key] = state == GLFW_PRESS || state == GLFW_REPEAT;
+        }
+        for (int button = 0; button <= GLFW_MOUSE_BUTTON_LAST; button++)
+            sample.MouseButtons[button] = glfwGetMouseButton(window, button) == GLFW_PRESS;
+
+        double xpos, ypos;
+        glfwGetCursorPos(window, &xpos, &ypos);
+        sample.MouseX = (float)xpos;
+        sample.MouseY = (float)ypos;
+
+        std::lock_guard<std::mutex> lock(s_SampleMutex);
+        s_Sampled = sample;
+    }
+
 }
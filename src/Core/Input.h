@@ -12,6 +12,10 @@ namespace S67 {
         static std::pair<float, float> GetMousePosition();
         static float GetMouseX();
         static float GetMouseY();
+
+        // Copies the current keyboard/mouse state for queries made off the
+        // main thread. Call on the main thread after polling events.
+        static void SampleState();
     };
 
 }
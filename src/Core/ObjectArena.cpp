@@ -0,0 +1,21 @@
+#include "ObjectArena.h"
+
+namespace S67 {
+
+void ObjectArena::Reset() {
+  for (auto it = m_Destructors.rbegin(); it != m_Destructors.rend(); ++it)
+    it->Destroy(it->Object);
+  m_Destructors.clear();
+  m_LiveObjects = 0;
+  m_CurrentBlock = 0;
+  m_Offset = 0;
+}
+
+size_t ObjectArena::GetReservedBytes() const {
+  size_t bytes = 0;
+  for (const Block &block : m_Blocks)
+    bytes += block.Size;
+  return bytes;
+}
+
+} // namespace S67
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace S67 {
+
+/**
+ * @brief Bump arena for objects that all die together
+ *
+ * Objects are placed back to back in BLOCK_SIZE blocks and never freed one at
+ * a time; Reset() runs every destructor (newest first) and rewinds the arena,
+ * keeping its blocks for the next round. Objects larger than a block get a
+ * block of their own. Not thread safe.
+ *
+ * Everything Create<T>() reaches is inline: game modules instantiate their
+ * scripts through it and link against headers only.
+ */
+class ObjectArena {
+public:
+  static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+  ObjectArena() = default;
+  ObjectArena(const ObjectArena &) = delete;
+  ObjectArena &operator=(const ObjectArena &) = delete;
+  ~ObjectArena() { Reset(); }
+
+  template <typename T, typename... Args> T *Create(Args &&...args) {
+    void *memory = Allocate(sizeof(T), alignof(T));
+    T *object = new (memory) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>)
+      m_Destructors.push_back(
+          {object, [](void *pointer) { static_cast<T *>(pointer)->~T(); }});
+    m_LiveObjects++;
+    return object;
+  }
+
+  // Destroys every object created since the last Reset()
+  void Reset();
+
+  size_t GetLiveObjects() const { return m_LiveObjects; }
+  size_t GetReservedBytes() const;
+
+private:
+  struct Block {
+    std::unique_ptr<std::byte[]> Memory;
+    size_t Size;
+  };
+  struct Destructor {
+    void *Object;
+    void (*Destroy)(void *);
+  };
+
+  void *Allocate(size_t size, size_t alignment) {
+    while (m_CurrentBlock < m_Blocks.size()) {
+      Block &block = m_Blocks[m_CurrentBlock];
+      uintptr_t base = reinterpret_cast<uintptr_t>(block.Memory.get());
+      uintptr_t address = (base + m_Offset + alignment - 1) & ~(alignment - 1);
+      size_t offset = address - base;
+      if (offset + size <= block.Size) {
+        m_Offset = offset + size;
+        return block.Memory.get() + offset;
+      }
+      m_CurrentBlock++;
+      m_Offset = 0;
+    }
+
+    size_t blockSize = std::max(BLOCK_SIZE, size + alignment);
+    m_Blocks.push_back({std::make_unique<std::byte[]>(blockSize), blockSize});
+    m_CurrentBlock = m_Blocks.size() - 1;
+    m_Offset = 0;
+    return Allocate(size, alignment);
+  }
+
+  std::vector<Block> m_Blocks;
+  size_t m_CurrentBlock = 0;
+  size_t m_Offset = 0;
+  std::vector<Destructor> m_Destructors;
+  size_t m_LiveObjects = 0;
+};
+
+} // namespace S67
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace S67 {
+
+/**
+ * @brief Vector that keeps its first N elements inline
+ *
+ * For per-entity lists that are almost always short (tags, scripts): an
+ * entity with N or fewer never touches the heap for the list itself, and a
+ * component pool page keeps them next to the rest of the component. Past N it
+ * grows on the heap like std::vector. Iterators are plain pointers and, as
+ * with std::vector, are invalidated by anything that grows the list.
+ */
+template <typename T, size_t N> class SmallVector {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  SmallVector() = default;
+  SmallVector(std::initializer_list<T> init) {
+    reserve(init.size());
+    for (const T &value : init)
+      push_back(value);
+  }
+  SmallVector(const SmallVector &other) { CopyFrom(other); }
+  SmallVector(SmallVector &&other) noexcept { MoveFrom(other); }
+  ~SmallVector() {
+    clear();
+    ReleaseHeap();
+  }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      clear();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this != &other) {
+      clear();
+      ReleaseHeap();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  iterator begin() { return m_Data; }
+  iterator end() { return m_Data + m_Size; }
+  const_iterator begin() const { return m_Data; }
+  const_iterator end() const { return m_Data + m_Size; }
+
+  size_t size() const { return m_Size; }
+  size_t capacity() const { return m_Capacity; }
+  bool empty() const { return m_Size == 0; }
+  bool IsInline() const { return m_Data == InlineData(); }
+
+  T &operator[](size_t index) { return m_Data[index]; }
+  const T &operator[](size_t index) const { return m_Data[index]; }
+  T &front() { return m_Data[0]; }
+  const T &front() const { return m_Data[0]; }
+  T &back() { return m_Data[m_Size - 1]; }
+  const T &back() const { return m_Data[m_Size - 1]; }
+  T *data() { return m_Data; }
+  const T *data() const { return m_Data; }
+
+  void reserve(size_t capacity) {
+    if (capacity <= m_Capacity)
+      return;
+
+    T *data = std::allocator<T>().allocate(capacity);
+    std::uninitialized_move(begin(), end(), data);
+    std::destroy(begin(), end());
+    ReleaseHeap();
+    m_Data = data;
+    m_Capacity = capacity;
+  }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (m_Size == m_Capacity) {
+      // args may refer into this list, so build the element before growing
+      T value(std::forward<Args>(args)...);
+      reserve(m_Capacity * 2);
+      return *new (m_Data + m_Size++) T(std::move(value));
+    }
+    return *new (m_Data + m_Size++) T(std::forward<Args>(args)...);
+  }
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() { std::destroy_at(m_Data + --m_Size); }
+
+  iterator erase(const_iterator position) {
+    T *target = m_Data + (position - m_Data);
+    std::move(target + 1, end(), target);
+    pop_back();
+    return target;
+  }
+
+  void clear() {
+    std::destroy(begin(), end());
+    m_Size = 0;
+  }
+
+  bool operator==(const SmallVector &other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+  bool operator!=(const SmallVector &other) const { return !(*this == other); }
+
+private:
+  T *InlineData() { return std::launder(reinterpret_cast<T *>(m_Inline)); }
+  const T *InlineData() const {
+    return std::launder(reinterpret_cast<const T *>(m_Inline));
+  }
+
+  void ReleaseHeap() {
+    if (!IsInline())
+      std::allocator<T>().deallocate(m_Data, m_Capacity);
+    m_Data = InlineData();
+    m_Capacity = N;
+  }
+
+  // Both expect this list to be empty
+  void CopyFrom(const SmallVector &other) {
+    reserve(other.m_Size);
+    std::uninitialized_copy(other.begin(), other.end(), m_Data);
+    m_Size = other.m_Size;
+  }
+  void MoveFrom(SmallVector &other) {
+    if (other.IsInline()) {
+      std::uninitialized_move(other.begin(), other.end(), m_Data);
+      m_Size = other.m_Size;
+      other.clear();
+      return;
+    }
+
+    // Steal the heap buffer and leave other empty and inline
+    m_Data = other.m_Data;
+    m_Size = other.m_Size;
+    m_Capacity = other.m_Capacity;
+    other.m_Data = other.InlineData();
+    other.m_Size = 0;
+    other.m_Capacity = N;
+  }
+
+  alignas(T) std::byte m_Inline[N * sizeof(T)];
+  T *m_Data = InlineData();
+  size_t m_Size = 0;
+  size_t m_Capacity = N;
+};
+
+} // namespace S67
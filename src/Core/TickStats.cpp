@@ -0,0 +1,84 @@
+#include "TickStats.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace S67 {
+
+void TickStats::Record(const TickFrameSample &sample) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Samples[m_Next] = sample;
+  m_Next = (m_Next + 1) % CAPACITY;
+  m_Count = std::min(m_Count + 1, CAPACITY);
+
+  m_Totals.TotalFrames++;
+  m_Totals.TotalTicks += sample.Ticks;
+  m_Totals.TotalLateTicks += sample.LateTicks;
+  if (sample.ClampedTime > 0.0f)
+    m_Totals.ClampedFrames++;
+  m_Totals.TotalClampedTime += sample.ClampedTime;
+  m_Totals.TotalBudgetDropped += sample.BudgetDropped;
+}
+
+void TickStats::Reset() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Next = 0;
+  m_Count = 0;
+  m_Totals = Summary();
+}
+
+// Nearest-rank percentiles; sorts values in place
+static TickStats::Percentiles ComputePercentiles(std::vector<float> &values) {
+  TickStats::Percentiles result;
+  if (values.empty())
+    return result;
+
+  std::sort(values.begin(), values.end());
+  auto rank = [&](float p) {
+    size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5f);
+    return values[std::min(index, values.size() - 1)];
+  };
+  result.P50 = rank(0.50f);
+  result.P95 = rank(0.95f);
+  result.P99 = rank(0.99f);
+  result.Max = values.back();
+  return result;
+}
+
+TickStats::Summary TickStats::Summarize() const {
+  std::array<TickFrameSample, CAPACITY> samples;
+  size_t count;
+  Summary summary;
+  {
+    // Copy out so the writer is only blocked for a memcpy
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    samples = m_Samples;
+    count = m_Count;
+    summary = m_Totals;
+  }
+  summary.Samples = count;
+
+  std::vector<float> values(count);
+  auto percentilesOf = [&](float TickFrameSample::*field) {
+    for (size_t i = 0; i < count; i++)
+      values[i] = samples[i].*field;
+    return ComputePercentiles(values);
+  };
+  auto percentilesOfCount = [&](uint32_t TickFrameSample::*field) {
+    for (size_t i = 0; i < count; i++)
+      values[i] = static_cast<float>(samples[i].*field);
+    return ComputePercentiles(values);
+  };
+
+  summary.Ticks = percentilesOfCount(&TickFrameSample::Ticks);
+  summary.LateTicks = percentilesOfCount(&TickFrameSample::LateTicks);
+  summary.ClampedTime = percentilesOf(&TickFrameSample::ClampedTime);
+  summary.BudgetDropped = percentilesOf(&TickFrameSample::BudgetDropped);
+  summary.AccumulatorResidue =
+      percentilesOf(&TickFrameSample::AccumulatorResidue);
+  summary.TickTime = percentilesOf(&TickFrameSample::TickTime);
+  return summary;
+}
+
+} // namespace S67
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace S67 {
+
+/**
+ * @brief What the fixed-tick loop did during one call of AdvanceSimulation
+ *
+ * All times are in seconds.
+ */
+struct TickFrameSample {
+  uint32_t Ticks = 0;              // Ticks run this frame
+  uint32_t LateTicks = 0;          // Ticks that took longer than a tick to run
+  float ClampedTime = 0.0f;        // Frame time dropped by MAX_FRAME_TIME
+  float BudgetDropped = 0.0f;      // Whole ticks dropped by host_maxticks
+  float AccumulatorResidue = 0.0f; // Unconsumed time left after the ticks
+  float TickTime = 0.0f;           // Wall time spent inside the ticks
+};
+
+/**
+ * @brief Rolling tick health telemetry
+ *
+ * Keeps the last CAPACITY frame samples in a ring buffer plus running totals
+ * since the last Reset(). Written by whichever thread advances the
+ * simulation, read by the stats panel and the host_tickstats command.
+ */
+class TickStats {
+public:
+  static constexpr size_t CAPACITY = 1024;
+
+  struct Percentiles {
+    float P50 = 0.0f, P95 = 0.0f, P99 = 0.0f, Max = 0.0f;
+  };
+
+  struct Summary {
+    size_t Samples = 0; // Frames in the window the percentiles cover
+    Percentiles Ticks, LateTicks, ClampedTime, BudgetDropped,
+        AccumulatorResidue, TickTime;
+
+    // Running totals since Reset()
+    uint64_t TotalFrames = 0;
+    uint64_t TotalTicks = 0;
+    uint64_t TotalLateTicks = 0;
+    uint64_t ClampedFrames = 0;
+    double TotalClampedTime = 0.0;
+    double TotalBudgetDropped = 0.0;
+  };
+
+  void Record(const TickFrameSample &sample);
+  void Reset();
+  Summary Summarize() const;
+
+private:
+  mutable std::mutex m_Mutex;
+  std::array<TickFrameSample, CAPACITY> m_Samples;
+  size_t m_Next = 0;
+  size_t m_Count = 0;
+  Summary m_Totals;
+};
+
+} // namespace S67
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace S67 {
+
+/**
+ * @brief Lock-free single-producer / single-consumer triple buffer
+ *
+ * The producer fills GetWriteBuffer() and calls Publish(); the consumer calls
+ * Fetch() and reads GetReadBuffer(). Neither side ever blocks: the producer
+ * always owns one slot, the consumer owns another and the third is swapped
+ * between them through a single atomic. The consumer always sees the newest
+ * published value; intermediate ones are dropped.
+ */
+template <typename T> class TripleBuffer {
+public:
+  TripleBuffer() = default;
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  // Producer side
+  T &GetWriteBuffer() { return m_Buffers[m_WriteIndex]; }
+  void Publish() {
+    uint8_t previous =
+        m_Shared.exchange(m_WriteIndex | FRESH_BIT, std::memory_order_acq_rel);
+    m_WriteIndex = previous & INDEX_MASK;
+  }
+
+  // Consumer side. Returns true if a newer value became readable.
+  bool Fetch() {
+    if ((m_Shared.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+      return false;
+    uint8_t previous =
+        m_Shared.exchange(m_ReadIndex, std::memory_order_acq_rel);
+    m_ReadIndex = previous & INDEX_MASK;
+    return true;
+  }
+  const T &GetReadBuffer() const { return m_Buffers[m_ReadIndex]; }
+
+  // Only safe while neither side is running (e.g. before the producer starts)
+  void Reset(const T &value) {
+    for (auto &buffer : m_Buffers)
+      buffer = value;
+    m_WriteIndex = 0;
+    m_Shared.store(1, std::memory_order_relaxed);
+    m_ReadIndex = 2;
+  }
+
+private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t FRESH_BIT = 0x4;
+
+  T m_Buffers[3];
+  uint8_t m_WriteIndex = 0;               // producer-owned
+  std::atomic<uint8_t> m_Shared{1};       // slot in flight + fresh flag
+  uint8_t m_ReadIndex = 2;                // consumer-owned
+};
+
+} // namespace S67
@@ -77,6 +77,56 @@ struct StandardCommands {
           Application::Get().OpenScene(resolvedPath.string());
         },
         "Load a map/scene by filename");
+
+    static ConCommand cmd_tickstats(
+        "host_tickstats",
+        [](const ConCommandArgs &args) {
+          TickStats &stats = Application::Get().GetTickStats();
+          if (args.ArgC() >= 2 && args[1] == "reset") {
+            stats.Reset();
+            S67_CORE_INFO("Tick stats reset");
+            return;
+          }
+
+          TickStats::Summary s = stats.Summarize();
+          S67_CORE_INFO("--- Tick Health (last {0} frames) ---", s.Samples);
+          auto print = [](const char *label, const TickStats::Percentiles &p,
+                          float scale) {
+            S67_CORE_INFO("{0:<14} p50 {1:8.3f}  p95 {2:8.3f}  p99 {3:8.3f}  "
+                          "max {4:8.3f}",
+                          label, p.P50 * scale, p.P95 * scale, p.P99 * scale,
+                          p.Max * scale);
+          };
+          print("ticks/frame", s.Ticks, 1.0f);
+          print("late ticks", s.LateTicks, 1.0f);
+          print("tick ms", s.TickTime, 1000.0f);
+          print("residue ms", s.AccumulatorResidue, 1000.0f);
+          print("clamped ms", s.ClampedTime, 1000.0f);
+          print("budget drop ms", s.BudgetDropped, 1000.0f);
+          S67_CORE_INFO("Totals: {0} frames, {1} ticks, {2} late, {3} clamped "
+                        "frames, {4:.1f} ms frame clamp, {5:.1f} ms tick "
+                        "budget",
+                        s.TotalFrames, s.TotalTicks, s.TotalLateTicks,
+                        s.ClampedFrames, s.TotalClampedTime * 1000.0,
+                        s.TotalBudgetDropped * 1000.0);
+        },
+        "Print tick loop percentiles (ticks/frame, dropped time, residue, "
+        "late ticks). 'host_tickstats reset' clears them");
+
+    static ConCommand cmd_streamstatus(
+        "stream_status",
+        [](const ConCommandArgs & /*args*/) {
+          const LevelStreamer::Statistics &s =
+              Application::Get().GetLevelStreamer().GetStatistics();
+          S67_CORE_INFO("Chunks: {0}/{1} loaded, {2} entities tracked",
+                        s.LoadedChunks, s.Chunks, s.TrackedEntities);
+          S67_CORE_INFO("Assets: {0} pending, {1} meshes and {2} textures "
+                        "resident",
+                        s.PendingAssets, s.ResidentMeshes, s.ResidentTextures);
+          S67_CORE_INFO("Last frame: {0} uploads in {1:.2f} ms",
+                        s.UploadsLastFrame, s.UploadMillisLastFrame);
+        },
+        "Print level streaming state (chunks, pending and resident assets)");
   }
 };
 
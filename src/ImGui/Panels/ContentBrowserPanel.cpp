@@ -1,6 +1,7 @@
 #include "ContentBrowserPanel.h"
 #include "Core/Application.h"
 #include "Core/PlatformUtils.h"
+#include "Renderer/TextureCache.h"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
@@ -19,26 +20,26 @@ ContentBrowserPanel::ContentBrowserPanel()
   std::filesystem::path levelIconPath =
       Application::Get().ResolveAssetPath("assets/engine/level_icon.png");
   if (std::filesystem::exists(levelIconPath)) {
-    m_LevelIcon = Texture2D::Create(levelIconPath.string());
+    m_LevelIcon = TextureCache::Load(levelIconPath.string());
   }
 
   std::filesystem::path folderIconPath =
       Application::Get().ResolveAssetPath("assets/engine/folder_icon.png");
   if (std::filesystem::exists(folderIconPath)) {
-    m_FolderIcon = Texture2D::Create(folderIconPath.string());
+    m_FolderIcon = TextureCache::Load(folderIconPath.string());
   }
 
   std::filesystem::path backIconPath =
       Application::Get().ResolveAssetPath("assets/engine/back_arrow_icon.png");
   if (std::filesystem::exists(backIconPath)) {
-    m_BackArrowIcon = Texture2D::Create(backIconPath.string());
+    m_BackArrowIcon = TextureCache::Load(backIconPath.string());
   }
 }
 
 void ContentBrowserPanel::SetRoot(const std::filesystem::path &root) {
   m_BaseDirectory = root;
   m_CurrentDirectory = root;
-  m_ThumbnailCache.clear();
+  m_Thumbnails.clear();
 }
 
 void ContentBrowserPanel::OnImGuiRender() {
@@ -175,16 +176,17 @@ void ContentBrowserPanel::OnImGuiRender() {
       else if (isLevel && m_LevelIcon)
         iconID = (ImTextureID)(uint64_t)m_LevelIcon->GetRendererID();
       else if (isImage) {
-        if (m_ThumbnailCache.find(path.string()) == m_ThumbnailCache.end()) {
-          auto tex = Texture2D::Create(path.string());
-          if (tex)
-            m_ThumbnailCache[path.string()] = tex;
-        }
-        if (m_ThumbnailCache.count(path.string()) &&
-            m_ThumbnailCache[path.string()]) {
-          iconID = (ImTextureID)(uint64_t)m_ThumbnailCache[path.string()]
-                       ->GetRendererID();
+        // Reloaded when the file is written; a failed load is remembered as
+        // nullptr so it isn't retried until then
+        std::error_code error;
+        auto writeTime = entry.last_write_time(error);
+        auto [it, inserted] = m_Thumbnails.try_emplace(path.string());
+        if (inserted || it->second.WriteTime != writeTime) {
+          it->second.Texture = TextureCache::Load(path.string());
+          it->second.WriteTime = writeTime;
         }
+        if (it->second.Texture)
+          iconID = (ImTextureID)(uint64_t)it->second.Texture->GetRendererID();
       }
 
       if (iconID != 0) {
@@ -24,7 +24,13 @@ private:
 
   std::filesystem::path m_BaseDirectory;
   std::filesystem::path m_CurrentDirectory;
-  std::unordered_map<std::string, Ref<Texture2D>> m_ThumbnailCache;
+  // Thumbnails of the images browsed so far, held so the TextureCache keeps
+  // them resident while the panel shows them
+  struct Thumbnail {
+    Ref<Texture2D> Texture;
+    std::filesystem::file_time_type WriteTime;
+  };
+  std::unordered_map<std::string, Thumbnail> m_Thumbnails;
 
   char m_SearchBuffer[256] = {0};
   bool m_ShowSidebar = true;
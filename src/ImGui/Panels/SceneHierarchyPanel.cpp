@@ -1,8 +1,11 @@
 #include "SceneHierarchyPanel.h"
 #include "Core/Application.h"
 #include "Core/Logger.h"
+#include "Core/PlatformUtils.h"
 #include "Core/UndoSystem.h"
+#include "Renderer/SceneSerializer.h"
 #include "Renderer/ScriptRegistry.h"
+#include "Renderer/TextureCache.h"
 #include <filesystem>
 #include <glm/gtc/type_ptr.hpp>
 #include <imgui.h>
@@ -22,8 +25,20 @@ void SceneHierarchyPanel::OnImGuiRender() {
   ImGui::Begin("Scene Hierarchy");
 
   if (m_Context) {
+    // Roots in scene order; each node draws its own children
     for (auto &entity : (*m_Context)->GetEntities()) {
-      DrawEntityNode(entity);
+      if (!(*m_Context)->GetParent(entity))
+        DrawEntityNode(entity);
+    }
+
+    // Dropping an entity on empty space makes it a root again
+    if (ImGui::BeginDragDropTargetCustom(ImGui::GetCurrentWindow()->InnerRect,
+                                         ImGui::GetID("HierarchyRoot"))) {
+      if (const ImGuiPayload *payload =
+              ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+        m_PendingReparent = {*(const uint32_t *)payload->Data,
+                             EntityHandle::INVALID};
+      ImGui::EndDragDropTarget();
     }
   }
 
@@ -44,7 +59,18 @@ void SceneHierarchyPanel::OnImGuiRender() {
   if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
     m_SelectionContext = nullptr;
 
-  // Defer deletion
+  // Defer reparenting, the tree above was drawn from the old links
+  if (m_PendingReparent.first != EntityHandle::INVALID) {
+    Ref<Entity> child = (*m_Context)->GetEntity(
+        EntityHandle::FromValue(m_PendingReparent.first));
+    Ref<Entity> parent = (*m_Context)->GetEntity(
+        EntityHandle::FromValue(m_PendingReparent.second));
+    if (child && !(*m_Context)->SetParent(child, parent) && parent)
+      S67_CORE_WARN("Cannot parent '{0}' under '{1}'", child->Name,
+                    parent->Name);
+    m_PendingReparent = {EntityHandle::INVALID, EntityHandle::INVALID};
+  }
+
   // Defer deletion
   if (m_EntityToDelete) {
     if (m_EntityToDelete->Name == "Player") {
@@ -69,14 +95,14 @@ void SceneHierarchyPanel::OnImGuiRender() {
     if (ImGui::InputText("Name", buffer, sizeof(buffer),
                          ImGuiInputTextFlags_EnterReturnsTrue)) {
       if (m_RenamingEntity)
-        m_RenamingEntity->Name = buffer;
+        (*m_Context)->RenameEntity(m_RenamingEntity, buffer);
       m_RenamingEntity = nullptr;
       ImGui::CloseCurrentPopup();
     }
 
     if (ImGui::Button("OK", ImVec2(120, 0))) {
       if (m_RenamingEntity)
-        m_RenamingEntity->Name = buffer;
+        (*m_Context)->RenameEntity(m_RenamingEntity, buffer);
       m_RenamingEntity = nullptr;
       ImGui::CloseCurrentPopup();
     }
@@ -107,6 +133,9 @@ void SceneHierarchyPanel::DrawEntityNode(Ref<Entity> entity) {
            : 0) |
       ImGuiTreeNodeFlags_OpenOnArrow;
   flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+  const auto &children = (*m_Context)->GetChildren(entity);
+  if (!children.empty())
+    flags |= ImGuiTreeNodeFlags_DefaultOpen;
   bool opened = ImGui::TreeNodeEx((void *)(uint64_t)entity.get(), flags, "%s",
                                   name.c_str());
   if (ImGui::IsItemClicked()) {
@@ -119,6 +148,23 @@ void SceneHierarchyPanel::DrawEntityNode(Ref<Entity> entity) {
       if (ImGui::MenuItem("Rename"))
         m_RenamingEntity = entity;
 
+      if ((*m_Context)->GetParent(entity) && ImGui::MenuItem("Unparent"))
+        m_PendingReparent = {entity->GetHandle().Value,
+                             EntityHandle::INVALID};
+
+      if (ImGui::MenuItem("Save as Prefab...")) {
+        std::string filepath = FileDialogs::SaveFile(
+            "Source67 Prefab (*.s67prefab)\0*.s67prefab\0",
+            (entity->Name + SceneSerializer::PREFAB_EXTENSION).c_str(),
+            SceneSerializer::PREFAB_EXTENSION);
+        if (!filepath.empty()) {
+          SceneSerializer serializer(
+              m_Context->get(), Application::Get().GetProjectRoot().string());
+          if (serializer.SerializePrefab(entity, filepath))
+            Application::Get().SetSceneModified(true);
+        }
+      }
+
       if (ImGui::MenuItem("Delete Geometry"))
         m_EntityToDelete = entity;
     } else {
@@ -128,7 +174,24 @@ void SceneHierarchyPanel::DrawEntityNode(Ref<Entity> entity) {
     ImGui::EndPopup();
   }
 
+  // The player is driven by its controller in world space, keep it a root
+  if (entity->Name != "Player" &&
+      ImGui::BeginDragDropSource(ImGuiDragDropFlags_None)) {
+    uint32_t handle = entity->GetHandle().Value;
+    ImGui::SetDragDropPayload("SCENE_HIERARCHY_ENTITY", &handle,
+                              sizeof(handle));
+    ImGui::Text("%s", name.c_str());
+    ImGui::EndDragDropSource();
+  }
+
   if (ImGui::BeginDragDropTarget()) {
+    if (const ImGuiPayload *payload =
+            ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY")) {
+      if (entity->Name != "Player")
+        m_PendingReparent = {*(const uint32_t *)payload->Data,
+                             entity->GetHandle().Value};
+    }
+
     // ... (Drag Drop Logic) ...
     if (const ImGuiPayload *payload =
             ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM")) {
@@ -140,8 +203,10 @@ void SceneHierarchyPanel::DrawEntityNode(Ref<Entity> entity) {
       bool isImage = ext == ".png" || ext == ".jpg" || ext == ".jpeg" ||
                      ext == ".bmp" || ext == ".tga";
 
-      if (isImage) {
-        auto newTexture = Texture2D::Create(assetPath.string());
+      Ref<Texture2D> newTexture;
+      if (isImage)
+        newTexture = TextureCache::Load(assetPath.string());
+      if (newTexture) {
         S67_CORE_INFO("Dropped texture {0} onto {1}", assetPath.string(),
                       entity->Name);
         Application::Get().GetUndoSystem().AddCommand(
@@ -174,6 +239,11 @@ void SceneHierarchyPanel::DrawEntityNode(Ref<Entity> entity) {
         m_SelectionIsMaterial = true;
       }
     }
+
+    for (EntityHandle child : children) {
+      if (Ref<Entity> childEntity = (*m_Context)->GetEntity(child))
+        DrawEntityNode(childEntity);
+    }
     ImGui::TreePop();
   }
 }
@@ -426,6 +496,21 @@ void SceneHierarchyPanel::DrawProperties(Ref<Entity> entity) {
       });
     }
 
+    if (!entity->PrefabPath.empty()) {
+      DrawComponent("Prefab", [&]() {
+        ImGui::Text("Prefab: %s",
+                    std::filesystem::path(entity->PrefabPath)
+                        .filename()
+                        .string()
+                        .c_str());
+        // Unlinked entities save their full record again
+        if (ImGui::Button("Unlink")) {
+          entity->PrefabPath.clear();
+          Application::Get().SetSceneModified(true);
+        }
+      });
+    }
+
     DrawComponent("Mesh", [&]() {
       // Simple mesh selection placeholder text for now, could expand later
       ImGui::Text("Mesh Asset: %s", entity->MeshPath.c_str());
@@ -453,8 +538,8 @@ void SceneHierarchyPanel::DrawProperties(Ref<Entity> entity) {
       ImGui::InputText("##NewTag", tagBuffer, sizeof(tagBuffer));
       ImGui::SameLine();
       if (ImGui::Button("Add Tag")) {
-        if (entity->Tags.size() < 10 && strlen(tagBuffer) > 0) {
-          entity->Tags.push_back(tagBuffer);
+        if (entity->Tags.size() < 10 &&
+            (*m_Context)->AddTag(entity, tagBuffer)) {
           tagBuffer[0] = '\0';
           Application::Get().SetSceneModified(true);
         }
@@ -466,7 +551,7 @@ void SceneHierarchyPanel::DrawProperties(Ref<Entity> entity) {
         ImGui::Text("%s", entity->Tags[i].c_str());
         ImGui::SameLine();
         if (ImGui::Button("X")) {
-          entity->Tags.erase(entity->Tags.begin() + i);
+          (*m_Context)->RemoveTag(entity, entity->Tags[i]);
           Application::Get().SetSceneModified(true);
           ImGui::PopID();
           break;
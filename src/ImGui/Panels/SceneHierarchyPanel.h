@@ -3,6 +3,7 @@
 #include "Core/Base.h"
 #include "Renderer/Scene.h"
 #include <imgui.h>
+#include <utility>
 
 namespace S67 {
 
@@ -37,6 +38,9 @@ private:
   bool m_SelectionIsMaterial = false;
   Ref<Entity> m_EntityToDelete; // Defer deletion
   Ref<Entity> m_RenamingEntity; // Rename state
+  // Deferred (child, new parent) handle values; INVALID parent unparents
+  std::pair<uint32_t, uint32_t> m_PendingReparent = {EntityHandle::INVALID,
+                                                     EntityHandle::INVALID};
   CreatePrimitiveType m_PendingCreateType = CreatePrimitiveType::None;
 };
 
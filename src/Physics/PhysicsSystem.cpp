@@ -1,6 +1,7 @@
 #include "PhysicsSystem.h"
 #include "Core/Logger.h"
 #include "Core/Assert.h"
+#include "Game/Console/ConVar.h"
 #include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
 #include <Jolt/Physics/Collision/RayCast.h>
 #include <Jolt/Physics/Collision/CastResult.h>
@@ -8,12 +9,10 @@
 
 namespace S67 {
 
-    // Fixed timestep for physics (66Hz to match Source Engine tick rate)
-    namespace {
-        static float s_PhysicsAccumulator = 0.0f;
-        static constexpr float FIXED_PHYSICS_DT = 1.0f / 66.0f;  // ~0.015151515f (15.15ms)
-        static constexpr int MAX_PHYSICS_STEPS = 5;
-    }
+    // Physics is stepped exactly once per game tick; this only splits that
+    // step into more collision passes for fast-moving bodies
+    static ConVar phys_substeps("phys_substeps", "1", FCVAR_ARCHIVE,
+                                "Jolt collision steps per game tick", true, 1.0f, true, 8.0f);
 
     // --- Jolt Boilerplate ---
 
@@ -104,19 +103,7 @@ namespace S67 {
     }
 
     void PhysicsSystem::OnUpdate(Timestep ts) {
-        s_PhysicsAccumulator += ts.GetSeconds();
-        
-        int steps = 0;
-        while (s_PhysicsAccumulator >= FIXED_PHYSICS_DT && steps < MAX_PHYSICS_STEPS) {
-            s_PhysicsSystem->Update(FIXED_PHYSICS_DT, 1, s_TempAllocator, s_JobSystem);
-            s_PhysicsAccumulator -= FIXED_PHYSICS_DT;
-            steps++;
-        }
-        
-        // Prevent spiral of death
-        if (s_PhysicsAccumulator > FIXED_PHYSICS_DT * MAX_PHYSICS_STEPS) {
-            s_PhysicsAccumulator = FIXED_PHYSICS_DT;
-        }
+        s_PhysicsSystem->Update(ts.GetSeconds(), phys_substeps.GetInt(), s_TempAllocator, s_JobSystem);
     }
 
     JPH::BodyID PhysicsSystem::Raycast(const glm::vec3& origin, const glm::vec3& direction, float distance) {
@@ -130,6 +117,12 @@ namespace S67 {
         return JPH::BodyID();
     }
 
+    EntityHandle PhysicsSystem::GetBodyEntity(const JPH::BodyID& body) {
+        if (body.IsInvalid())
+            return EntityHandle();
+        return EntityHandle::FromUserData(GetBodyInterface().GetUserData(body));
+    }
+
     // --- Default Filters ---
     class DefaultBroadPhaseLayerFilter : public JPH::BroadPhaseLayerFilter {
     public:
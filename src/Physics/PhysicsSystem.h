@@ -15,6 +15,7 @@
 #include <glm/glm.hpp>
 #include "Core/Base.h"
 #include "Core/Timestep.h"
+#include "Renderer/EntityHandle.h"
 
 namespace S67 {
 
@@ -29,12 +30,19 @@ namespace S67 {
         static void Init();
         static void Shutdown();
 
+        // One Jolt update of exactly ts, split into phys_substeps collision steps.
+        // Called once per game tick; catch-up is the tick loop's job.
         static void OnUpdate(Timestep ts);
 
         static JPH::PhysicsSystem& GetPhysicsSystem() { return *s_PhysicsSystem; }
         static JPH::BodyInterface& GetBodyInterface() { return s_PhysicsSystem->GetBodyInterface(); }
+        // Only for code that already owns the physics world (i.e. runs inside a tick)
+        static JPH::BodyInterface& GetBodyInterfaceNoLock() { return s_PhysicsSystem->GetBodyInterfaceNoLock(); }
 
         static JPH::BodyID Raycast(const glm::vec3& origin, const glm::vec3& direction, float distance);
+        // Entity a body was created for (its user data); resolve it through the scene,
+        // which rejects handles of entities deleted since
+        static EntityHandle GetBodyEntity(const JPH::BodyID& body);
 
         static const JPH::BroadPhaseLayerFilter& GetBroadPhaseLayerFilter();
         static const JPH::ObjectLayerFilter& GetObjectLayerFilter();
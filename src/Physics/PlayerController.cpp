@@ -8,6 +8,7 @@
 #include "Physics/PhysicsSystem.h"
 #include "Renderer/Entity.h"
 #include <GLFW/glfw3.h>
+#include <Jolt/Physics/Body/Body.h>
 #include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
 #include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
 #include <algorithm>
@@ -46,17 +47,26 @@ static ConVar sv_max_air_wishspeed(
     "sv_max_air_wishspeed", "30.0", FCVAR_ARCHIVE | FCVAR_NOTIFY,
     "Maximum speed the player can wish for in air (clamps strafing)");
 
+// Runs for every body the character sweeps against. The body is already
+// locked, so its user data is read directly; the entity handle in it resolves
+// with an array index, and bodies left behind by deleted entities are skipped
+// instead of dereferenced.
 class PlayerBodyFilter : public JPH::BodyFilter {
 public:
-  virtual bool ShouldCollide(const JPH::BodyID &inBodyID) const override {
-    JPH::BodyInterface &bodyInterface = PhysicsSystem::GetBodyInterface();
-    uint64_t userData = bodyInterface.GetUserData(inBodyID);
-    if (userData != 0) {
-      Entity *entity = (Entity *)userData;
-      return entity->Collidable;
-    }
-    return true;
+  explicit PlayerBodyFilter(const EntityRegistry &registry)
+      : m_Registry(registry) {}
+
+  virtual bool ShouldCollideLocked(const JPH::Body &inBody) const override {
+    EntityHandle handle = EntityHandle::FromUserData(inBody.GetUserData());
+    if (!handle.IsValid())
+      return true;
+    if (!m_Registry.Contains(handle))
+      return false;
+    return m_Registry.Get<PhysicsBodyComponent>(handle).Collidable;
   }
+
+private:
+  const EntityRegistry &m_Registry;
 };
 
 PlayerController::PlayerController() {}
@@ -65,7 +75,7 @@ void PlayerController::OnCreate() {
   S67_CORE_INFO("PlayerController::OnCreate Start");
   auto &app = Application::Get();
   S67_CORE_INFO("Got Application instance");
-  m_Camera = app.GetCamera(); // Access Global Camera
+  m_Camera = app.GetPlayerCamera(); // Simulation-side player view
   if (!m_Camera)
     S67_CORE_ERROR("Camera is null!");
   S67_CORE_INFO("PlayerController::OnCreate Camera Retrieved");
@@ -214,7 +224,7 @@ void PlayerController::OnUpdate(float ts) {
   m_Character->SetLinearVelocity(newJVel);
 
   // 4. Update Character (Collision)
-  PlayerBodyFilter bodyFilter;
+  PlayerBodyFilter bodyFilter(Application::Get().GetScene().GetRegistry());
   m_Character->Update(dt, JPH::Vec3::sZero(), // Gravity applied manually
                       PhysicsSystem::GetBroadPhaseLayerFilter(),
                       PhysicsSystem::GetObjectLayerFilter(), bodyFilter,
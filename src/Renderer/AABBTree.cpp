@@ -0,0 +1,210 @@
+#include "AABBTree.h"
+#include <algorithm>
+
+namespace S67 {
+
+int32_t AABBTree::CreateProxy(const AABB &box, uint32_t userData) {
+  int32_t proxy = AllocateNode();
+  m_Nodes[proxy].Box = box.Expanded(MARGIN);
+  m_Nodes[proxy].UserData = userData;
+  m_Nodes[proxy].Height = 0;
+  InsertLeaf(proxy);
+  m_ProxyCount++;
+  return proxy;
+}
+
+void AABBTree::DestroyProxy(int32_t proxy) {
+  RemoveLeaf(proxy);
+  FreeNode(proxy);
+  m_ProxyCount--;
+}
+
+bool AABBTree::MoveProxy(int32_t proxy, const AABB &box) {
+  AABB &fat = m_Nodes[proxy].Box;
+  // A box that shrank well inside its fat box is refitted too, or a body
+  // that spawned large and settled would keep a bloated leaf forever
+  if (fat.Contains(box) && box.Expanded(MARGIN * 4.0f).Contains(fat))
+    return false;
+
+  RemoveLeaf(proxy);
+  m_Nodes[proxy].Box = box.Expanded(MARGIN);
+  InsertLeaf(proxy);
+  return true;
+}
+
+void AABBTree::Clear() {
+  m_Nodes.clear();
+  m_Root = NULL_NODE;
+  m_FreeList = NULL_NODE;
+  m_ProxyCount = 0;
+}
+
+int32_t AABBTree::AllocateNode() {
+  if (m_FreeList == NULL_NODE) {
+    m_Nodes.emplace_back();
+    return static_cast<int32_t>(m_Nodes.size() - 1);
+  }
+
+  int32_t index = m_FreeList;
+  m_FreeList = m_Nodes[index].Parent;
+  m_Nodes[index] = Node();
+  return index;
+}
+
+void AABBTree::FreeNode(int32_t index) {
+  m_Nodes[index].Parent = m_FreeList;
+  m_Nodes[index].Height = -1;
+  m_FreeList = index;
+}
+
+void AABBTree::InsertLeaf(int32_t leaf) {
+  if (m_Root == NULL_NODE) {
+    m_Root = leaf;
+    m_Nodes[leaf].Parent = NULL_NODE;
+    return;
+  }
+
+  // Walk down to the cheapest sibling: the cost of a node is the area it
+  // adds to every ancestor plus the area of the new parent
+  const AABB leafBox = m_Nodes[leaf].Box;
+  int32_t index = m_Root;
+  while (!m_Nodes[index].IsLeaf()) {
+    const Node &node = m_Nodes[index];
+    float area = node.Box.GetSurfaceArea();
+    float combinedArea = AABB::Merge(node.Box, leafBox).GetSurfaceArea();
+
+    // Cost of a new parent here, and of pushing the leaf further down
+    float cost = 2.0f * combinedArea;
+    float inheritanceCost = 2.0f * (combinedArea - area);
+
+    auto childCost = [&](int32_t child) {
+      const AABB &box = m_Nodes[child].Box;
+      float merged = AABB::Merge(box, leafBox).GetSurfaceArea();
+      if (m_Nodes[child].IsLeaf())
+        return merged + inheritanceCost;
+      return merged - box.GetSurfaceArea() + inheritanceCost;
+    };
+    float cost1 = childCost(node.Child1);
+    float cost2 = childCost(node.Child2);
+
+    if (cost < cost1 && cost < cost2)
+      break;
+    index = cost1 < cost2 ? node.Child1 : node.Child2;
+  }
+
+  // New parent for the sibling and the leaf
+  int32_t sibling = index;
+  int32_t oldParent = m_Nodes[sibling].Parent;
+  int32_t newParent = AllocateNode();
+  m_Nodes[newParent].Parent = oldParent;
+  m_Nodes[newParent].Box = AABB::Merge(leafBox, m_Nodes[sibling].Box);
+  m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+  m_Nodes[newParent].Child1 = sibling;
+  m_Nodes[newParent].Child2 = leaf;
+  m_Nodes[sibling].Parent = newParent;
+  m_Nodes[leaf].Parent = newParent;
+
+  if (oldParent == NULL_NODE) {
+    m_Root = newParent;
+  } else if (m_Nodes[oldParent].Child1 == sibling) {
+    m_Nodes[oldParent].Child1 = newParent;
+  } else {
+    m_Nodes[oldParent].Child2 = newParent;
+  }
+
+  // Refit and rebalance the ancestors
+  for (index = m_Nodes[leaf].Parent; index != NULL_NODE;
+       index = m_Nodes[index].Parent) {
+    index = Balance(index);
+    Node &node = m_Nodes[index];
+    node.Height = 1 + std::max(m_Nodes[node.Child1].Height,
+                               m_Nodes[node.Child2].Height);
+    node.Box = AABB::Merge(m_Nodes[node.Child1].Box, m_Nodes[node.Child2].Box);
+  }
+}
+
+void AABBTree::RemoveLeaf(int32_t leaf) {
+  if (leaf == m_Root) {
+    m_Root = NULL_NODE;
+    return;
+  }
+
+  // The sibling takes the parent's place
+  int32_t parent = m_Nodes[leaf].Parent;
+  int32_t grandParent = m_Nodes[parent].Parent;
+  int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2
+                                                    : m_Nodes[parent].Child1;
+  FreeNode(parent);
+
+  if (grandParent == NULL_NODE) {
+    m_Root = sibling;
+    m_Nodes[sibling].Parent = NULL_NODE;
+    return;
+  }
+
+  if (m_Nodes[grandParent].Child1 == parent)
+    m_Nodes[grandParent].Child1 = sibling;
+  else
+    m_Nodes[grandParent].Child2 = sibling;
+  m_Nodes[sibling].Parent = grandParent;
+
+  for (int32_t index = grandParent; index != NULL_NODE;
+       index = m_Nodes[index].Parent) {
+    index = Balance(index);
+    Node &node = m_Nodes[index];
+    node.Height = 1 + std::max(m_Nodes[node.Child1].Height,
+                               m_Nodes[node.Child2].Height);
+    node.Box = AABB::Merge(m_Nodes[node.Child1].Box, m_Nodes[node.Child2].Box);
+  }
+}
+
+// Rotates the taller child up if the subtree at a is out of balance by more
+// than one level. Returns the subtree's new root.
+int32_t AABBTree::Balance(int32_t a) {
+  Node &nodeA = m_Nodes[a];
+  if (nodeA.IsLeaf() || nodeA.Height < 2)
+    return a;
+
+  int32_t b = nodeA.Child1;
+  int32_t c = nodeA.Child2;
+  int32_t balance = m_Nodes[c].Height - m_Nodes[b].Height;
+  if (balance >= -1 && balance <= 1)
+    return a;
+
+  // The taller child moves up
+  int32_t up = balance > 1 ? c : b;
+  Node &nodeUp = m_Nodes[up];
+  int32_t f = nodeUp.Child1;
+  int32_t g = nodeUp.Child2;
+
+  // up replaces a under a's parent
+  nodeUp.Child1 = a;
+  nodeUp.Parent = nodeA.Parent;
+  nodeA.Parent = up;
+  if (nodeUp.Parent == NULL_NODE) {
+    m_Root = up;
+  } else if (m_Nodes[nodeUp.Parent].Child1 == a) {
+    m_Nodes[nodeUp.Parent].Child1 = up;
+  } else {
+    m_Nodes[nodeUp.Parent].Child2 = up;
+  }
+
+  // up keeps its taller child; the shorter one goes to a
+  int32_t keep = m_Nodes[f].Height > m_Nodes[g].Height ? f : g;
+  int32_t give = keep == f ? g : f;
+  nodeUp.Child2 = keep;
+  if (balance > 1)
+    nodeA.Child2 = give;
+  else
+    nodeA.Child1 = give;
+  m_Nodes[give].Parent = a;
+
+  nodeA.Box = AABB::Merge(m_Nodes[nodeA.Child1].Box, m_Nodes[nodeA.Child2].Box);
+  nodeA.Height = 1 + std::max(m_Nodes[nodeA.Child1].Height,
+                              m_Nodes[nodeA.Child2].Height);
+  nodeUp.Box = AABB::Merge(nodeA.Box, m_Nodes[keep].Box);
+  nodeUp.Height = 1 + std::max(nodeA.Height, m_Nodes[keep].Height);
+  return up;
+}
+
+} // namespace S67
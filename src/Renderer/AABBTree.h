@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Core/SmallVector.h"
+#include "Renderer/Bounds.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace S67 {
+
+/**
+ * @brief Dynamic bounding volume tree
+ *
+ * Leaves hold a fattened copy of each proxy's box, so objects that move a
+ * little stay inside their leaf and cost nothing; only a proxy that leaves
+ * its fat box is reinserted. Insertion picks the sibling by surface area
+ * heuristic and the tree is kept balanced with AVL-style rotations, so
+ * queries stay O(log n) however the proxies were added.
+ *
+ * Queries take a visitor called with each overlapping proxy; returning false
+ * stops the query. Visitors run against the fat boxes, so callers that need
+ * exact results test their own tight bounds.
+ */
+class AABBTree {
+public:
+  static constexpr int32_t NULL_NODE = -1;
+  static constexpr float MARGIN = 0.1f;
+
+  int32_t CreateProxy(const AABB &box, uint32_t userData);
+  void DestroyProxy(int32_t proxy);
+  // Returns true if the proxy had to be reinserted
+  bool MoveProxy(int32_t proxy, const AABB &box);
+  void Clear();
+
+  const AABB &GetFatAABB(int32_t proxy) const { return m_Nodes[proxy].Box; }
+  uint32_t GetUserData(int32_t proxy) const {
+    return m_Nodes[proxy].UserData;
+  }
+  size_t GetProxyCount() const { return m_ProxyCount; }
+  int32_t GetHeight() const {
+    return m_Root == NULL_NODE ? 0 : m_Nodes[m_Root].Height;
+  }
+
+  template <typename Visitor>
+  void Query(const AABB &box, Visitor &&visit) const {
+    Traverse([&box](const AABB &node) { return box.Overlaps(node); }, visit);
+  }
+
+  template <typename Visitor>
+  void QuerySphere(const glm::vec3 &center, float radius,
+                   Visitor &&visit) const {
+    float radiusSquared = radius * radius;
+    Traverse(
+        [&](const AABB &node) {
+          return node.DistanceSquared(center) <= radiusSquared;
+        },
+        visit);
+  }
+
+  // Subtrees entirely inside the frustum are reported without further plane
+  // tests
+  template <typename Visitor>
+  void QueryFrustum(const Frustum &frustum, Visitor &&visit) const {
+    if (m_Root == NULL_NODE)
+      return;
+
+    SmallVector<std::pair<int32_t, bool>, 64> stack;
+    stack.push_back({m_Root, false});
+    while (!stack.empty()) {
+      auto [index, inside] = stack.back();
+      stack.pop_back();
+      const Node &node = m_Nodes[index];
+
+      if (!inside) {
+        Frustum::Result result = frustum.Classify(node.Box);
+        if (result == Frustum::Result::Outside)
+          continue;
+        inside = result == Frustum::Result::Inside;
+      }
+
+      if (node.IsLeaf()) {
+        if (!visit(index))
+          return;
+      } else {
+        stack.push_back({node.Child1, inside});
+        stack.push_back({node.Child2, inside});
+      }
+    }
+  }
+
+  // Visitor is called as float(int32_t proxy, float maxT) with the ray
+  // clipped to maxT so far, and returns the new maxT: a hit distance to keep
+  // only nearer proxies, maxT to go on unchanged, or a negative value to
+  // stop. Direction need not be normalized; t is in units of it.
+  template <typename Visitor>
+  void RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxT,
+               Visitor &&visit) const {
+    if (m_Root == NULL_NODE)
+      return;
+
+    glm::vec3 invDirection = 1.0f / direction;
+    SmallVector<int32_t, 64> stack;
+    stack.push_back(m_Root);
+    while (!stack.empty()) {
+      int32_t index = stack.back();
+      stack.pop_back();
+      const Node &node = m_Nodes[index];
+
+      float tEntry;
+      if (!node.Box.IntersectRay(origin, invDirection, maxT, tEntry))
+        continue;
+
+      if (node.IsLeaf()) {
+        maxT = visit(index, maxT);
+        if (maxT < 0.0f)
+          return;
+      } else {
+        stack.push_back(node.Child1);
+        stack.push_back(node.Child2);
+      }
+    }
+  }
+
+private:
+  struct Node {
+    AABB Box;
+    uint32_t UserData = 0;
+    int32_t Parent = NULL_NODE; // Next free node while on the free list
+    int32_t Child1 = NULL_NODE;
+    int32_t Child2 = NULL_NODE;
+    int32_t Height = 0; // Leaf = 0, free = -1
+
+    bool IsLeaf() const { return Child1 == NULL_NODE; }
+  };
+
+  template <typename Test, typename Visitor>
+  void Traverse(const Test &test, Visitor &visit) const {
+    if (m_Root == NULL_NODE)
+      return;
+
+    SmallVector<int32_t, 64> stack;
+    stack.push_back(m_Root);
+    while (!stack.empty()) {
+      int32_t index = stack.back();
+      stack.pop_back();
+      const Node &node = m_Nodes[index];
+      if (!test(node.Box))
+        continue;
+
+      if (node.IsLeaf()) {
+        if (!visit(index))
+          return;
+      } else {
+        stack.push_back(node.Child1);
+        stack.push_back(node.Child2);
+      }
+    }
+  }
+
+  int32_t AllocateNode();
+  void FreeNode(int32_t index);
+  void InsertLeaf(int32_t leaf);
+  void RemoveLeaf(int32_t leaf);
+  int32_t Balance(int32_t index);
+
+  std::vector<Node> m_Nodes;
+  int32_t m_Root = NULL_NODE;
+  int32_t m_FreeList = NULL_NODE;
+  size_t m_ProxyCount = 0;
+};
+
+} // namespace S67
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+namespace S67 {
+
+// Axis-aligned bounding box. The default box is the unit cube every built-in
+// mesh is modelled in.
+struct AABB {
+  glm::vec3 Min = glm::vec3(-0.5f);
+  glm::vec3 Max = glm::vec3(0.5f);
+
+  glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+  glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+  float GetSurfaceArea() const {
+    glm::vec3 d = Max - Min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+  }
+
+  bool Contains(const AABB &other) const {
+    return glm::all(glm::lessThanEqual(Min, other.Min)) &&
+           glm::all(glm::greaterThanEqual(Max, other.Max));
+  }
+  bool Overlaps(const AABB &other) const {
+    return glm::all(glm::lessThanEqual(Min, other.Max)) &&
+           glm::all(glm::greaterThanEqual(Max, other.Min));
+  }
+  float DistanceSquared(const glm::vec3 &point) const {
+    glm::vec3 d = glm::max(glm::max(Min - point, point - Max), glm::vec3(0.0f));
+    return glm::dot(d, d);
+  }
+
+  AABB Expanded(float margin) const {
+    return {Min - glm::vec3(margin), Max + glm::vec3(margin)};
+  }
+  static AABB Merge(const AABB &a, const AABB &b) {
+    return {glm::min(a.Min, b.Min), glm::max(a.Max, b.Max)};
+  }
+
+  // Box enclosing this one after an affine transform (Arvo's method)
+  AABB Transformed(const glm::mat4 &m) const {
+    glm::vec3 center = glm::vec3(m * glm::vec4(GetCenter(), 1.0f));
+    glm::vec3 extents = GetExtents();
+    glm::vec3 worldExtents =
+        glm::abs(glm::vec3(m[0])) * extents.x +
+        glm::abs(glm::vec3(m[1])) * extents.y +
+        glm::abs(glm::vec3(m[2])) * extents.z;
+    return {center - worldExtents, center + worldExtents};
+  }
+
+  // Slab test. invDirection is 1/direction per axis (inf for 0 is fine).
+  // On a hit, tEntry is where the ray enters the box (0 if it starts inside).
+  bool IntersectRay(const glm::vec3 &origin, const glm::vec3 &invDirection,
+                    float maxT, float &tEntry) const {
+    glm::vec3 t0 = (Min - origin) * invDirection;
+    glm::vec3 t1 = (Max - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+    if (enter > exit)
+      return false;
+    tEntry = enter;
+    return true;
+  }
+};
+
+// Sphere enclosing a mesh, centered on its box. The default one encloses the
+// unit cube.
+struct BoundingSphere {
+  glm::vec3 Center = glm::vec3(0.0f);
+  float Radius = 0.8660254f; // sqrt(3) / 2
+};
+
+// View frustum as six inward-facing planes (xyz normal, w distance)
+struct Frustum {
+  enum class Result { Outside, Intersects, Inside };
+
+  glm::vec4 Planes[6];
+
+  // Gribb/Hartmann extraction from an OpenGL clip-space matrix
+  static Frustum FromMatrix(const glm::mat4 &viewProjection) {
+    glm::mat4 m = glm::transpose(viewProjection);
+    Frustum frustum;
+    frustum.Planes[0] = m[3] + m[0]; // Left
+    frustum.Planes[1] = m[3] - m[0]; // Right
+    frustum.Planes[2] = m[3] + m[1]; // Bottom
+    frustum.Planes[3] = m[3] - m[1]; // Top
+    frustum.Planes[4] = m[3] + m[2]; // Near
+    frustum.Planes[5] = m[3] - m[2]; // Far
+    for (glm::vec4 &plane : frustum.Planes)
+      plane /= glm::length(glm::vec3(plane));
+    return frustum;
+  }
+
+  Result Classify(const AABB &box) const {
+    glm::vec3 center = box.GetCenter();
+    glm::vec3 extents = box.GetExtents();
+    Result result = Result::Inside;
+    for (const glm::vec4 &plane : Planes) {
+      glm::vec3 normal = glm::vec3(plane);
+      float distance = glm::dot(normal, center) + plane.w;
+      float radius = glm::dot(glm::abs(normal), extents);
+      if (distance < -radius)
+        return Result::Outside;
+      if (distance < radius)
+        result = Result::Intersects;
+    }
+    return result;
+  }
+  bool Intersects(const AABB &box) const {
+    return Classify(box) != Result::Outside;
+  }
+};
+
+} // namespace S67
@@ -1,4 +1,5 @@
 #include "Buffer.h"
+#include <algorithm>
 #include <glad/glad.h>
 
 namespace S67 {
@@ -7,12 +8,20 @@ namespace S67 {
 
     class OpenGLVertexBuffer : public VertexBuffer {
     public:
-        OpenGLVertexBuffer(float* vertices, uint32_t size) {
+        OpenGLVertexBuffer(float* vertices, uint32_t size)
+            : m_Size(size) {
             glGenBuffers(1, &m_RendererID);
             glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
             glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
         }
 
+        OpenGLVertexBuffer(uint32_t size)
+            : m_Size(size) {
+            glGenBuffers(1, &m_RendererID);
+            glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        }
+
         virtual ~OpenGLVertexBuffer() {
             if (m_RendererID != 0) {
                 glDeleteBuffers(1, &m_RendererID);
@@ -26,8 +35,10 @@ namespace S67 {
         // Implement move operations
         OpenGLVertexBuffer(OpenGLVertexBuffer&& other) noexcept
             : m_RendererID(other.m_RendererID),
+              m_Size(other.m_Size),
               m_Layout(std::move(other.m_Layout)) {
             other.m_RendererID = 0;
+            other.m_Size = 0;
         }
 
         OpenGLVertexBuffer& operator=(OpenGLVertexBuffer&& other) noexcept {
@@ -39,10 +50,12 @@ namespace S67 {
                 
                 // Move data
                 m_RendererID = other.m_RendererID;
+                m_Size = other.m_Size;
                 m_Layout = std::move(other.m_Layout);
                 
                 // Nullify moved-from object
                 other.m_RendererID = 0;
+                other.m_Size = 0;
             }
             return *this;
         }
@@ -55,11 +68,29 @@ namespace S67 {
             glBindBuffer(GL_ARRAY_BUFFER, 0);
         }
 
+        virtual void SetData(const void* data, uint32_t size) override {
+            glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            // Fresh storage every time (grown if needed), so draws still
+            // reading the old contents don't stall the upload
+            m_Size = std::max(m_Size, size);
+            glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+        }
+
+        virtual void GetData(void* data, uint32_t size) const override {
+            glBindBuffer(GL_COPY_READ_BUFFER, m_RendererID);
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, std::min(size, m_Size), data);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+
+        virtual uint32_t GetSize() const override { return m_Size; }
+
         virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
         virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 
     private:
         uint32_t m_RendererID = 0;
+        uint32_t m_Size = 0;
         BufferLayout m_Layout;
     };
 
@@ -67,6 +98,10 @@ namespace S67 {
         return CreateRef<OpenGLVertexBuffer>(vertices, size);
     }
 
+    Ref<VertexBuffer> VertexBuffer::Create(uint32_t size) {
+        return CreateRef<OpenGLVertexBuffer>(size);
+    }
+
     // --- IndexBuffer --------------------------------------------------------
 
     class OpenGLIndexBuffer : public IndexBuffer {
@@ -124,6 +159,20 @@ namespace S67 {
 
         virtual uint32_t GetCount() const override { return m_Count; }
 
+        // Through the copy targets: binding GL_ELEMENT_ARRAY_BUFFER would
+        // attach the buffer to whichever vertex array is bound
+        virtual void GetData(uint32_t* indices, uint32_t count, uint32_t offset) const override {
+            glBindBuffer(GL_COPY_READ_BUFFER, m_RendererID);
+            glGetBufferSubData(GL_COPY_READ_BUFFER, offset * sizeof(uint32_t), count * sizeof(uint32_t), indices);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+
+        virtual void SetData(const uint32_t* indices, uint32_t count, uint32_t offset) override {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset * sizeof(uint32_t), count * sizeof(uint32_t), indices);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
     private:
         uint32_t m_RendererID = 0;
         uint32_t m_Count = 0;
@@ -133,4 +182,41 @@ namespace S67 {
         return CreateRef<OpenGLIndexBuffer>(indices, count);
     }
 
+    // --- UniformBuffer ------------------------------------------------------
+
+    class OpenGLUniformBuffer : public UniformBuffer {
+    public:
+        OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+            : m_Size(size) {
+            glGenBuffers(1, &m_RendererID);
+            glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+            glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+        }
+
+        virtual ~OpenGLUniformBuffer() {
+            if (m_RendererID != 0) {
+                glDeleteBuffers(1, &m_RendererID);
+            }
+        }
+
+        OpenGLUniformBuffer(const OpenGLUniformBuffer&) = delete;
+        OpenGLUniformBuffer& operator=(const OpenGLUniformBuffer&) = delete;
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset) override {
+            glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+            if (offset == 0 && size == m_Size)
+                glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        }
+
+    private:
+        uint32_t m_RendererID = 0;
+        uint32_t m_Size = 0;
+    };
+
+    Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding) {
+        return CreateRef<OpenGLUniformBuffer>(size, binding);
+    }
+
 }
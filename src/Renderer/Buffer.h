@@ -99,10 +99,18 @@ namespace S67 {
         virtual void Bind() const = 0;
         virtual void Unbind() const = 0;
 
+        // Replaces the contents, growing the buffer if needed
+        virtual void SetData(const void* data, uint32_t size) = 0;
+        // Copies the contents back from the GPU. Stalls; for load-time work.
+        virtual void GetData(void* data, uint32_t size) const = 0;
+        virtual uint32_t GetSize() const = 0;
+
         virtual void SetLayout(const BufferLayout& layout) = 0;
         virtual const BufferLayout& GetLayout() const = 0;
 
         static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
+        // Empty, for data that changes every frame
+        static Ref<VertexBuffer> Create(uint32_t size);
     };
 
     class IndexBuffer {
@@ -113,8 +121,25 @@ namespace S67 {
         virtual void Unbind() const = 0;
 
         virtual uint32_t GetCount() const = 0;
+        // count indices from offset (in indices); GetData stalls like the
+        // vertex buffer's. Neither touches the bound vertex array.
+        virtual void GetData(uint32_t* indices, uint32_t count, uint32_t offset = 0) const = 0;
+        virtual void SetData(const uint32_t* indices, uint32_t count, uint32_t offset = 0) = 0;
 
         static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
     };
 
+    // Block of uniforms shared by every program that declares it, attached to
+    // a fixed binding point for its whole life
+    class UniformBuffer {
+    public:
+        virtual ~UniformBuffer() {}
+
+        // Writing the whole buffer orphans the old storage, so draws still
+        // reading it don't stall the update
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+        static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
+    };
+
 }
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Core/Base.h"
+#include "Core/ObjectArena.h"
+#include "Core/SmallVector.h"
+#include "Renderer/AABBTree.h"
+#include "Renderer/Bounds.h"
+#include "Renderer/EntityHandle.h"
+#include "Renderer/Shader.h"
+#include "Renderer/Texture.h"
+#include "Renderer/VertexArray.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace S67 {
+
+class ScriptableEntity;
+
+struct LuaScriptComponent {
+  std::string FilePath;
+  bool Initialized = false;
+  std::filesystem::file_time_type LastWriteTime;
+  std::shared_ptr<void> Environment;
+};
+
+struct Transform {
+  glm::vec3 Position = {0.0f, 0.0f, 0.0f};
+  glm::vec3 Rotation = {0.0f, 0.0f, 0.0f}; // Euler angles
+  glm::vec3 Scale = {1.0f, 1.0f, 1.0f};
+
+  // translate * Rx * Ry * Rz * scale, in closed form (one sin/cos per axis)
+  glm::mat4 GetTransform() const {
+    glm::vec3 r = glm::radians(Rotation);
+    float cx = std::cos(r.x), sx = std::sin(r.x);
+    float cy = std::cos(r.y), sy = std::sin(r.y);
+    float cz = std::cos(r.z), sz = std::sin(r.z);
+
+    glm::mat4 m;
+    m[0] = glm::vec4(cy * cz, cx * sz + sx * sy * cz, sx * sz - cx * sy * cz,
+                     0.0f) * Scale.x;
+    m[1] = glm::vec4(-cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz,
+                     0.0f) * Scale.y;
+    m[2] = glm::vec4(sy, -sx * cy, cx * cy, 0.0f) * Scale.z;
+    m[3] = glm::vec4(Position, 1.0f);
+    return m;
+  }
+
+  // Inverse of GetTransform() for matrices without shear. Angles come back
+  // in (-180, 180], so they may differ from the ones that built the matrix.
+  static Transform FromMatrix(const glm::mat4 &m) {
+    Transform t;
+    t.Position = glm::vec3(m[3]);
+    t.Scale = {glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])),
+               glm::length(glm::vec3(m[2]))};
+
+    glm::vec3 x = glm::vec3(m[0]) / t.Scale.x;
+    glm::vec3 y = glm::vec3(m[1]) / t.Scale.y;
+    glm::vec3 z = glm::vec3(m[2]) / t.Scale.z;
+    float ry = std::asin(glm::clamp(z.x, -1.0f, 1.0f));
+    float rx, rz;
+    if (std::abs(std::cos(ry)) > 1e-4f) {
+      rx = std::atan2(-z.y, z.z);
+      rz = std::atan2(-y.x, x.x);
+    } else {
+      // Gimbal lock: X and Z spin about the same axis, fold it all into X
+      rx = std::atan2(y.z, y.y);
+      rz = 0.0f;
+    }
+    t.Rotation = glm::degrees(glm::vec3(rx, ry, rz));
+    return t;
+  }
+
+  bool operator==(const Transform &other) const {
+    return Position == other.Position && Rotation == other.Rotation &&
+           Scale == other.Scale;
+  }
+  bool operator!=(const Transform &other) const { return !(*this == other); }
+};
+
+// World matrix cache, refreshed by EntityRegistry::UpdateWorldTransforms()
+struct WorldTransformComponent {
+  glm::mat4 World = glm::mat4(1.0f);
+  Transform Source;   // The Transform World was built from
+  uint32_t Stamp = 0; // Update pass that last rebuilt World
+  bool Valid = false;
+};
+
+// What the entity occupies in its local space, and the world box last handed
+// to the registry's spatial tree
+struct BoundsComponent {
+  AABB Local;
+  AABB World;
+  int32_t Proxy = AABBTree::NULL_NODE;
+  std::weak_ptr<VertexArray> Source; // Mesh Local was taken from
+};
+
+// Parent/child links. A child's Transform is relative to its parent.
+struct HierarchyComponent {
+  EntityHandle Parent;
+  std::vector<EntityHandle> Children;
+};
+
+struct NativeScriptComponent {
+  std::string Name;
+  ScriptableEntity *Instance = nullptr; // Owned by the scene's script arena
+
+  ScriptableEntity *(*InstantiateScript)(ObjectArena &) = nullptr;
+
+  template <typename T> void Bind(const std::string &name) {
+    Name = name;
+    InstantiateScript = [](ObjectArena &arena) {
+      return static_cast<ScriptableEntity *>(arena.Create<T>());
+    };
+  }
+};
+
+struct Material {
+  Ref<Texture2D> AlbedoMap;
+  // Texture to stream in while AlbedoMap is not resident (empty otherwise)
+  std::string AlbedoPath;
+  glm::vec2 Tiling = {1.0f, 1.0f};
+};
+
+struct MovementSettings {
+  float MaxSpeed = 190.0f;        // sv_maxspeed
+  float MaxSprintSpeed = 320.0f;  // Custom sprint speed
+  float MaxCrouchSpeed = 63.3f;   // sv_maxspeed (crouched) roughly 1/3
+  float Acceleration = 5.6f;      // sv_accelerate
+  float AirAcceleration = 100.0f; // sv_airaccelerate
+  float Friction = 4.8f;          // sv_friction
+  float StopSpeed = 100.0f;       // sv_stopspeed
+  float JumpVelocity = 268.0f;    // JUMP_VELOCITY
+  float Gravity = 800.0f;         // sv_gravity
+  float MaxAirWishSpeed = 30.0f;  // MAX_AIR_WISH_SPEED
+};
+
+// --- Registry component storage (see EntityRegistry) ---
+
+struct MeshRendererComponent {
+  Ref<VertexArray> Mesh;
+  Ref<Shader> MaterialShader;
+  S67::Material Material;
+  std::string MeshPath = "Cube";
+};
+
+struct PhysicsBodyComponent {
+  JPH::BodyID PhysicsBody = JPH::BodyID();
+  bool Collidable = true;
+  bool Anchored = false; // If true, object is static (no gravity)
+};
+
+// Most entities have at most one script of each kind and a couple of tags,
+// which then live inline in the component pool
+struct ScriptComponent {
+  SmallVector<NativeScriptComponent, 1> Scripts;
+  SmallVector<LuaScriptComponent, 1> LuaScripts;
+};
+
+struct TagComponent {
+  SmallVector<std::string, 2> Tags;
+  uint64_t Mask = 0; // Interned tag ids < 64, kept by EntityRegistry
+};
+
+// Prefab asset the entity was instantiated from (empty if none); levels only
+// store the fields where the entity differs from it
+struct PrefabComponent {
+  std::string Path;
+};
+
+} // namespace S67
@@ -0,0 +1,23 @@
+#include "Entity.h"
+
+namespace S67 {
+
+Entity::Entity(const Ref<EntityRegistry> &registry, EntityHandle handle)
+    : Transform(registry->Get<S67::Transform>(handle)),
+      Mesh(registry->Get<MeshRendererComponent>(handle).Mesh),
+      MaterialShader(registry->Get<MeshRendererComponent>(handle).MaterialShader),
+      Material(registry->Get<MeshRendererComponent>(handle).Material),
+      MeshPath(registry->Get<MeshRendererComponent>(handle).MeshPath),
+      PhysicsBody(registry->Get<PhysicsBodyComponent>(handle).PhysicsBody),
+      Collidable(registry->Get<PhysicsBodyComponent>(handle).Collidable),
+      Anchored(registry->Get<PhysicsBodyComponent>(handle).Anchored),
+      Movement(registry->Get<MovementSettings>(handle)),
+      Scripts(registry->Get<ScriptComponent>(handle).Scripts),
+      LuaScripts(registry->Get<ScriptComponent>(handle).LuaScripts),
+      Tags(registry->Get<TagComponent>(handle).Tags),
+      PrefabPath(registry->Get<PrefabComponent>(handle).Path),
+      m_Registry(registry), m_Handle(handle) {}
+
+Entity::~Entity() { m_Registry->Destroy(m_Handle); }
+
+} // namespace S67
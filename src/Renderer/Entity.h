@@ -1,113 +1,57 @@
 #pragma once
 
-#include "Renderer/Shader.h"
-#include "Renderer/Texture.h"
-#include "Renderer/VertexArray.h"
-#include <Jolt/Jolt.h>
-#include <Jolt/Physics/Body/BodyID.h>
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
+#include "Renderer/Components.h"
+#include "Renderer/EntityRegistry.h"
+#include "Renderer/ScriptableEntity.h"
 #include <string>
 #include <vector>
-#include <filesystem>
-#include <memory>
-#include "Renderer/ScriptableEntity.h"
-
-// Forward declaration
-namespace S67 {
-class ScriptableEntity;
-struct LuaScriptComponent {
-  std::string FilePath;
-  bool Initialized = false;
-  std::filesystem::file_time_type LastWriteTime;
-  std::shared_ptr<void> Environment;
-};
-}
 
 namespace S67 {
 
-struct Transform {
-  glm::vec3 Position = {0.0f, 0.0f, 0.0f};
-  glm::vec3 Rotation = {0.0f, 0.0f, 0.0f}; // Euler angles
-  glm::vec3 Scale = {1.0f, 1.0f, 1.0f};
+/**
+ * @brief Script-facing view of one entity
+ *
+ * The component data lives in the owning scene's EntityRegistry; the public
+ * members below are references into those packed pools, so existing code and
+ * scripts keep writing entity->Transform.Position while engine loops can
+ * walk the pools directly. Create entities with Scene::CreateEntity().
+ */
+class Entity {
+public:
+  Entity(const Ref<EntityRegistry> &registry, EntityHandle handle);
+  ~Entity();
 
-  glm::mat4 GetTransform() const {
-    glm::mat4 rotation =
-        glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.x), {1, 0, 0}) *
-        glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.y), {0, 1, 0}) *
-        glm::rotate(glm::mat4(1.0f), glm::radians(Rotation.z), {0, 0, 1});
+  Entity(const Entity &) = delete;
+  Entity &operator=(const Entity &) = delete;
 
-    return glm::translate(glm::mat4(1.0f), Position) * rotation *
-           glm::scale(glm::mat4(1.0f), Scale);
-  }
-};
+  EntityHandle GetHandle() const { return m_Handle; }
 
-// Forward declaration
-class ScriptableEntity;
-
-struct NativeScriptComponent {
-  std::string Name;
-  ScriptableEntity *Instance = nullptr;
-
-  ScriptableEntity *(*InstantiateScript)(NativeScriptComponent *);
-  void (*DestroyScript)(NativeScriptComponent *);
-
-  template <typename T> void Bind(const std::string &name) {
-    Name = name;
-    InstantiateScript = [](NativeScriptComponent *) {
-      return static_cast<ScriptableEntity *>(new T());
-    };
-    DestroyScript = [](NativeScriptComponent *nsc) {
-      delete nsc->Instance;
-      nsc->Instance = nullptr;
-    };
+  // As of the last EntityRegistry::UpdateWorldTransforms()
+  const glm::mat4 &GetWorldTransform() const {
+    return m_Registry->GetWorldTransform(m_Handle);
   }
-};
 
-struct Material {
-  Ref<Texture2D> AlbedoMap;
-  glm::vec2 Tiling = {1.0f, 1.0f};
-};
+  std::string Name = "Entity";
+  float CameraFOV = 45.0f;
 
-struct MovementSettings {
-  float MaxSpeed = 190.0f;        // sv_maxspeed
-  float MaxSprintSpeed = 320.0f;  // Custom sprint speed
-  float MaxCrouchSpeed = 63.3f;   // sv_maxspeed (crouched) roughly 1/3
-  float Acceleration = 5.6f;      // sv_accelerate
-  float AirAcceleration = 100.0f; // sv_airaccelerate
-  float Friction = 4.8f;          // sv_friction
-  float StopSpeed = 100.0f;       // sv_stopspeed
-  float JumpVelocity = 268.0f;    // JUMP_VELOCITY
-  float Gravity = 800.0f;         // sv_gravity
-  float MaxAirWishSpeed = 30.0f;  // MAX_AIR_WISH_SPEED
-};
+  S67::Transform &Transform;
 
-class Entity {
-public:
-  Entity() = default;
-  Entity(const std::string &name, const Ref<VertexArray> &va,
-         const Ref<Shader> &shader, const Ref<Texture2D> &texture)
-      : Name(name), Mesh(va), MaterialShader(shader) {
-    Material.AlbedoMap = texture;
-  }
+  Ref<VertexArray> &Mesh;
+  Ref<Shader> &MaterialShader;
+  S67::Material &Material;
+  std::string &MeshPath;
 
-  Transform Transform;
-  Ref<VertexArray> Mesh;
-  Ref<Shader> MaterialShader;
-  Material Material;
+  JPH::BodyID &PhysicsBody;
+  bool &Collidable;
+  bool &Anchored; // If true, object is static (no gravity)
 
-  JPH::BodyID PhysicsBody = JPH::BodyID();
-  std::string Name = "Entity";
-  std::string MeshPath = "Cube";
-  bool Collidable = true;
-  bool Anchored = false; // If true, object is static (no gravity)
-  float CameraFOV = 45.0f;
+  MovementSettings &Movement;
 
-  MovementSettings Movement;
+  SmallVector<NativeScriptComponent, 1> &Scripts;
+  SmallVector<LuaScriptComponent, 1> &LuaScripts;
+  SmallVector<std::string, 2> &Tags;
 
-  std::vector<NativeScriptComponent> Scripts;
-  std::vector<LuaScriptComponent> LuaScripts;
-  std::vector<std::string> Tags;
+  std::string &PrefabPath;
 
   template <typename T> T *GetScript() {
     for (auto &script : Scripts) {
@@ -117,13 +61,14 @@ public:
     return nullptr;
   }
 
+  // Interned bitmask test once the entity is in a scene
   bool HasTag(const std::string &tag) const {
-    for (const auto &t : Tags) {
-      if (t == tag)
-        return true;
-    }
-    return false;
+    return m_Registry->HasTag(m_Handle, tag);
   }
+
+private:
+  Ref<EntityRegistry> m_Registry;
+  EntityHandle m_Handle;
 };
 
 } // namespace S67
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+namespace S67 {
+
+/**
+ * @brief Stable 32-bit reference to an entity in an EntityRegistry
+ *
+ * The low bits index the registry's component storage, the high bits hold a
+ * generation that is bumped whenever the slot is freed, so a handle to a
+ * destroyed entity never resolves to whatever reuses its slot.
+ */
+struct EntityHandle {
+  static constexpr uint32_t INDEX_BITS = 22;
+  static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+  static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+  static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+  uint32_t Value = INVALID;
+
+  EntityHandle() = default;
+  EntityHandle(uint32_t index, uint32_t generation)
+      : Value(((generation & GENERATION_MASK) << INDEX_BITS) |
+              (index & INDEX_MASK)) {}
+
+  static EntityHandle FromValue(uint32_t value) {
+    EntityHandle handle;
+    handle.Value = value;
+    return handle;
+  }
+
+  // Jolt body user data. Bodies default to 0, so the handle is tagged to
+  // tell "no entity" apart from slot 0.
+  static constexpr uint64_t USER_DATA_TAG = uint64_t(1) << 32;
+  uint64_t ToUserData() const { return USER_DATA_TAG | Value; }
+  static EntityHandle FromUserData(uint64_t userData) {
+    return userData & USER_DATA_TAG ? FromValue(uint32_t(userData))
+                                    : EntityHandle();
+  }
+
+  uint32_t GetIndex() const { return Value & INDEX_MASK; }
+  uint32_t GetGeneration() const { return Value >> INDEX_BITS; }
+  bool IsValid() const { return Value != INVALID; }
+
+  bool operator==(const EntityHandle &other) const {
+    return Value == other.Value;
+  }
+  bool operator!=(const EntityHandle &other) const {
+    return Value != other.Value;
+  }
+};
+
+} // namespace S67
@@ -0,0 +1,606 @@
+#include "EntityRegistry.h"
+#include "Core/Assert.h"
+#include "Renderer/Entity.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace S67 {
+
+EntityHandle EntityRegistry::Create() {
+  uint32_t slot;
+  if (!m_FreeSlots.empty()) {
+    slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+  } else {
+    slot = static_cast<uint32_t>(m_Generations.size());
+    // The all-ones index is reserved so no live handle equals INVALID
+    S67_CORE_ASSERT(slot < EntityHandle::INDEX_MASK, "Entity limit reached");
+    m_Generations.push_back(0);
+    m_Sparse.push_back(NOT_PRESENT);
+    std::apply([slot](auto &...pools) { (pools.EnsureSlot(slot), ...); },
+               m_Pools);
+  }
+  return EntityHandle(slot, m_Generations[slot]);
+}
+
+void EntityRegistry::Destroy(EntityHandle handle) {
+  if (!IsAlive(handle))
+    return;
+
+  uint32_t slot = handle.GetIndex();
+  if (m_Sparse[slot] != NOT_PRESENT)
+    Remove(handle);
+  // A freed slot must not leave a leaf behind for queries to return
+  BoundsComponent &bounds = Get<BoundsComponent>(handle);
+  if (bounds.Proxy != AABBTree::NULL_NODE)
+    m_SpatialTree.DestroyProxy(bounds.Proxy);
+
+  std::apply([slot](auto &...pools) { (pools.ResetSlot(slot), ...); },
+             m_Pools);
+  m_Generations[slot] =
+      (m_Generations[slot] + 1) & EntityHandle::GENERATION_MASK;
+  m_FreeSlots.push_back(slot);
+}
+
+bool EntityRegistry::IsAlive(EntityHandle handle) const {
+  uint32_t slot = handle.GetIndex();
+  return handle.IsValid() && slot < m_Generations.size() &&
+         m_Generations[slot] == handle.GetGeneration();
+}
+
+void EntityRegistry::Add(const Ref<Entity> &entity) {
+  Insert(m_Dense.size(), entity);
+}
+
+void EntityRegistry::Insert(size_t position, const Ref<Entity> &entity) {
+  EntityHandle handle = entity->GetHandle();
+  S67_CORE_ASSERT(IsAlive(handle), "Entity belongs to another registry");
+  if (Contains(handle))
+    return;
+
+  position = std::min(position, m_Dense.size());
+  m_Dense.insert(m_Dense.begin() + position, entity);
+  m_DenseHandles.insert(m_DenseHandles.begin() + position, handle);
+  ReindexFrom(position);
+  IndexEntity(handle);
+  m_HierarchyDirty = true;
+}
+
+void EntityRegistry::Remove(EntityHandle handle) {
+  if (!Contains(handle))
+    return;
+
+  UnindexEntity(handle);
+  Detach(handle);
+
+  // Rebuilt (and back in the tree) if it rejoins
+  BoundsComponent &bounds = Get<BoundsComponent>(handle);
+  if (bounds.Proxy != AABBTree::NULL_NODE) {
+    m_SpatialTree.DestroyProxy(bounds.Proxy);
+    bounds.Proxy = AABBTree::NULL_NODE;
+  }
+  MarkTransformDirty(handle);
+
+  // Ordered erase: scene order is what the hierarchy panel shows
+  size_t position = m_Sparse[handle.GetIndex()];
+  m_Sparse[handle.GetIndex()] = NOT_PRESENT;
+  Ref<Entity> keepAlive = std::move(m_Dense[position]);
+  m_Dense.erase(m_Dense.begin() + position);
+  m_DenseHandles.erase(m_DenseHandles.begin() + position);
+  ReindexFrom(position);
+  m_HierarchyDirty = true;
+}
+
+void EntityRegistry::Clear() {
+  // Entities kept alive elsewhere (undo history, selection) must not keep
+  // links into the old scene
+  for (EntityHandle handle : m_DenseHandles) {
+    m_Sparse[handle.GetIndex()] = NOT_PRESENT;
+    Get<HierarchyComponent>(handle) = HierarchyComponent();
+    Get<BoundsComponent>(handle).Proxy = AABBTree::NULL_NODE;
+    MarkTransformDirty(handle);
+  }
+  m_DenseHandles.clear();
+  m_HierarchyOrder.clear();
+  m_HierarchyDirty = false;
+  m_SpatialTree.Clear();
+  m_NameIndex.clear();
+  m_TagIds.clear();
+  m_TagMembers.clear();
+
+  // Dropping the last references destroys the façades, which free their
+  // slots back into this registry
+  std::vector<Ref<Entity>> entities;
+  entities.swap(m_Dense);
+  entities.clear();
+}
+
+bool EntityRegistry::Contains(EntityHandle handle) const {
+  return IsAlive(handle) && m_Sparse[handle.GetIndex()] != NOT_PRESENT;
+}
+
+Ref<Entity> EntityRegistry::Find(EntityHandle handle) const {
+  if (!Contains(handle))
+    return nullptr;
+  return m_Dense[m_Sparse[handle.GetIndex()]];
+}
+
+void EntityRegistry::ReindexFrom(size_t position) {
+  for (size_t i = position; i < m_DenseHandles.size(); i++)
+    m_Sparse[m_DenseHandles[i].GetIndex()] = static_cast<uint32_t>(i);
+}
+
+Ref<Entity> EntityRegistry::FindByName(const std::string &name) const {
+  auto it = m_NameIndex.find(name);
+  if (it == m_NameIndex.end() || it->second.empty())
+    return nullptr;
+
+  // Duplicate names resolve to the first one in scene order, as a linear
+  // scan would
+  uint32_t best = NOT_PRESENT;
+  for (EntityHandle handle : it->second)
+    best = std::min(best, m_Sparse[handle.GetIndex()]);
+  return m_Dense[best];
+}
+
+void EntityRegistry::Rename(EntityHandle handle, const std::string &name) {
+  if (!IsAlive(handle))
+    return;
+
+  Ref<Entity> entity = Find(handle);
+  if (!entity) {
+    // Not a member, so not indexed; nothing else to update
+    return;
+  }
+
+  auto it = m_NameIndex.find(entity->Name);
+  if (it != m_NameIndex.end()) {
+    EraseHandle(it->second, handle);
+    if (it->second.empty())
+      m_NameIndex.erase(it);
+  }
+  entity->Name = name;
+  m_NameIndex[name].push_back(handle);
+}
+
+bool EntityRegistry::HasTag(EntityHandle handle, const std::string &tag) const {
+  const TagComponent &tags = Get<TagComponent>(handle);
+  if (tags.Tags.empty())
+    return false;
+
+  if (Contains(handle)) {
+    auto it = m_TagIds.find(tag);
+    if (it == m_TagIds.end())
+      return false;
+    if (it->second < 64)
+      return (tags.Mask >> it->second) & 1;
+  }
+
+  // Past the first 64 interned tags, or not indexed
+  for (const auto &t : tags.Tags) {
+    if (t == tag)
+      return true;
+  }
+  return false;
+}
+
+bool EntityRegistry::AddTag(EntityHandle handle, const std::string &tag) {
+  if (!IsAlive(handle) || tag.empty())
+    return false;
+
+  auto &tags = Get<TagComponent>(handle).Tags;
+  if (std::find(tags.begin(), tags.end(), tag) != tags.end())
+    return false;
+
+  tags.push_back(tag);
+  if (Contains(handle))
+    IndexTag(handle, tag);
+  return true;
+}
+
+void EntityRegistry::RemoveTag(EntityHandle handle, const std::string &tag) {
+  if (!IsAlive(handle))
+    return;
+
+  auto &tags = Get<TagComponent>(handle).Tags;
+  auto it = std::find(tags.begin(), tags.end(), tag);
+  if (it == tags.end())
+    return;
+
+  // tag may alias the element being erased
+  std::string removed = std::move(*it);
+  tags.erase(it);
+  if (Contains(handle))
+    UnindexTag(handle, removed);
+}
+
+const std::vector<EntityHandle> &
+EntityRegistry::GetTagged(const std::string &tag) const {
+  static const std::vector<EntityHandle> s_None;
+  auto it = m_TagIds.find(tag);
+  return it != m_TagIds.end() ? m_TagMembers[it->second] : s_None;
+}
+
+bool EntityRegistry::SetParent(EntityHandle child, EntityHandle parent) {
+  if (!Contains(child) || child == parent)
+    return false;
+  if (parent.IsValid() && (!Contains(parent) || IsAncestor(child, parent)))
+    return false;
+
+  HierarchyComponent &node = Get<HierarchyComponent>(child);
+  if (node.Parent == parent)
+    return true;
+
+  if (node.Parent.IsValid())
+    EraseHandle(Get<HierarchyComponent>(node.Parent).Children, child);
+  node.Parent = parent;
+  if (parent.IsValid())
+    Get<HierarchyComponent>(parent).Children.push_back(child);
+
+  MarkTransformDirty(child);
+  m_HierarchyDirty = true;
+  return true;
+}
+
+bool EntityRegistry::IsAncestor(EntityHandle ancestor,
+                                EntityHandle handle) const {
+  for (EntityHandle p = GetParent(handle); p.IsValid(); p = GetParent(p)) {
+    if (p == ancestor)
+      return true;
+  }
+  return false;
+}
+
+void EntityRegistry::Detach(EntityHandle handle) {
+  HierarchyComponent &node = Get<HierarchyComponent>(handle);
+  if (!node.Parent.IsValid() && node.Children.empty())
+    return;
+
+  if (node.Parent.IsValid())
+    EraseHandle(Get<HierarchyComponent>(node.Parent).Children, handle);
+
+  // Children become roots; their Transforms are now read as world space
+  for (EntityHandle child : node.Children) {
+    Get<HierarchyComponent>(child).Parent = EntityHandle();
+    MarkTransformDirty(child);
+  }
+  node = HierarchyComponent();
+  m_HierarchyDirty = true;
+}
+
+void EntityRegistry::RebuildHierarchyOrder() {
+  m_HierarchyOrder.clear();
+  std::vector<EntityHandle> stack;
+  for (EntityHandle root : m_DenseHandles) {
+    if (GetParent(root).IsValid())
+      continue;
+
+    // Depth-first, children in the order they were attached
+    stack.push_back(root);
+    while (!stack.empty()) {
+      EntityHandle handle = stack.back();
+      stack.pop_back();
+      m_HierarchyOrder.push_back(handle.GetIndex());
+      const auto &children = GetChildren(handle);
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+  }
+  m_HierarchyDirty = false;
+}
+
+size_t EntityRegistry::UpdateWorldTransforms(
+    std::vector<EntityHandle> *changed) {
+  auto &transforms = std::get<ComponentPool<Transform>>(m_Pools);
+  auto &worlds = std::get<ComponentPool<WorldTransformComponent>>(m_Pools);
+  const auto &hierarchy = std::get<ComponentPool<HierarchyComponent>>(m_Pools);
+  const auto &meshes = std::get<ComponentPool<MeshRendererComponent>>(m_Pools);
+  auto &bounds = std::get<ComponentPool<BoundsComponent>>(m_Pools);
+
+  if (m_HierarchyDirty)
+    RebuildHierarchyOrder();
+  if (++m_WorldStamp == 0)
+    m_WorldStamp = 1; // 0 is what a fresh slot holds
+
+  // One pass in topological order: a parent is always settled before its
+  // children, and a child is rebuilt if it changed or its parent was rebuilt
+  // this pass. Untouched subtrees cost one 36-byte compare per entity.
+  m_DirtyScratch.clear();
+  for (uint32_t slot : m_HierarchyOrder) {
+    // Left the scene since the order was built
+    if (m_Sparse[slot] == NOT_PRESENT)
+      continue;
+    bool refit = SyncLocalBounds(bounds[slot], meshes[slot].Mesh);
+    WorldTransformComponent &world = worlds[slot];
+    EntityHandle parent = hierarchy[slot].Parent;
+    const WorldTransformComponent *parentWorld =
+        parent.IsValid() ? &worlds[parent.GetIndex()] : nullptr;
+
+    if (world.Valid && world.Source == transforms[slot] &&
+        (!parentWorld || parentWorld->Stamp != m_WorldStamp)) {
+      // Unchanged, but not in the tree yet (restored from a snapshot) or
+      // given a different mesh
+      if (bounds[slot].Proxy == AABBTree::NULL_NODE || refit)
+        UpdateBounds(slot, world.World);
+      continue;
+    }
+
+    world.Source = transforms[slot];
+    world.World = parentWorld ? parentWorld->World * world.Source.GetTransform()
+                              : world.Source.GetTransform();
+    world.Stamp = m_WorldStamp;
+    world.Valid = true;
+    UpdateBounds(slot, world.World);
+    m_DirtyScratch.push_back(slot);
+  }
+
+  if (changed) {
+    for (uint32_t slot : m_DirtyScratch)
+      changed->push_back(EntityHandle(slot, m_Generations[slot]));
+  }
+  return m_DirtyScratch.size();
+}
+
+void EntityRegistry::UpdateBounds(uint32_t slot, const glm::mat4 &world) {
+  auto &pool = std::get<ComponentPool<BoundsComponent>>(m_Pools);
+  BoundsComponent &bounds = pool[slot];
+  bounds.World = bounds.Local.Transformed(world);
+  if (bounds.Proxy == AABBTree::NULL_NODE) {
+    bounds.Proxy = m_SpatialTree.CreateProxy(
+        bounds.World, EntityHandle(slot, m_Generations[slot]).Value);
+  } else {
+    m_SpatialTree.MoveProxy(bounds.Proxy, bounds.World);
+  }
+}
+
+// Takes the local box from the entity's mesh when the mesh changed, however
+// it was assigned (level load, streaming, prefabs, drops, the inspector). An
+// entity whose mesh was streamed out keeps the box it had.
+bool EntityRegistry::SyncLocalBounds(BoundsComponent &bounds,
+                                     const Ref<VertexArray> &mesh) {
+  // Compared by owner: the weak reference keeps the old control block alive,
+  // so a new mesh can't alias a freed one
+  if (!mesh || (!bounds.Source.owner_before(mesh) &&
+                !mesh.owner_before(bounds.Source)))
+    return false;
+
+  bounds.Local = mesh->GetBounds();
+  bounds.Source = mesh;
+  return true;
+}
+
+void EntityRegistry::SetLocalBounds(EntityHandle handle, const AABB &bounds) {
+  if (!IsAlive(handle))
+    return;
+
+  BoundsComponent &component = Get<BoundsComponent>(handle);
+  component.Local = bounds;
+  component.Source = Get<MeshRendererComponent>(handle).Mesh;
+  const WorldTransformComponent &world = Get<WorldTransformComponent>(handle);
+  if (Contains(handle) && world.Valid)
+    UpdateBounds(handle.GetIndex(), world.World);
+}
+
+void EntityRegistry::QueryBox(const AABB &box,
+                              std::vector<EntityHandle> &out) const {
+  m_SpatialTree.Query(box, [&](int32_t proxy) {
+    EntityHandle handle = ProxyEntity(proxy);
+    if (GetWorldBounds(handle).Overlaps(box))
+      out.push_back(handle);
+    return true;
+  });
+}
+
+void EntityRegistry::QuerySphere(const glm::vec3 &center, float radius,
+                                 std::vector<EntityHandle> &out) const {
+  float radiusSquared = radius * radius;
+  m_SpatialTree.QuerySphere(center, radius, [&](int32_t proxy) {
+    EntityHandle handle = ProxyEntity(proxy);
+    if (GetWorldBounds(handle).DistanceSquared(center) <= radiusSquared)
+      out.push_back(handle);
+    return true;
+  });
+}
+
+void EntityRegistry::QueryFrustum(const Frustum &frustum,
+                                  std::vector<EntityHandle> &out) const {
+  m_SpatialTree.QueryFrustum(frustum, [&](int32_t proxy) {
+    EntityHandle handle = ProxyEntity(proxy);
+    if (frustum.Intersects(GetWorldBounds(handle)))
+      out.push_back(handle);
+    return true;
+  });
+}
+
+EntityHandle EntityRegistry::Raycast(const glm::vec3 &origin,
+                                     const glm::vec3 &direction,
+                                     float maxDistance, float *hitDistance,
+                                     const EntityFilter &filter) const {
+  glm::vec3 dir = glm::normalize(direction);
+  EntityHandle hit;
+  float hitT = maxDistance;
+  auto visit = [&](int32_t proxy, float maxT) {
+    EntityHandle handle = ProxyEntity(proxy);
+    if (filter && !filter(handle))
+      return maxT;
+
+    // Oriented test: into the entity's local space, where the ray keeps its
+    // parameterisation since the map is affine
+    const glm::mat4 &world = GetWorldTransform(handle);
+    float t;
+    if (std::abs(glm::determinant(world)) < 1e-12f) {
+      // Flattened to nothing on some axis; fall back to the world box
+      if (!GetWorldBounds(handle).IntersectRay(origin, 1.0f / dir, maxT, t))
+        return maxT;
+    } else {
+      glm::mat4 toLocal = glm::inverse(world);
+      glm::vec3 localOrigin = glm::vec3(toLocal * glm::vec4(origin, 1.0f));
+      glm::vec3 localDir = glm::vec3(toLocal * glm::vec4(dir, 0.0f));
+      if (!Get<BoundsComponent>(handle).Local.IntersectRay(
+              localOrigin, 1.0f / localDir, maxT, t))
+        return maxT;
+    }
+
+    hit = handle;
+    hitT = t;
+    return t;
+  };
+  m_SpatialTree.RayCast(origin, dir, maxDistance, visit);
+
+  if (hit.IsValid() && hitDistance)
+    *hitDistance = hitT;
+  return hit;
+}
+
+EntityHandle EntityRegistry::FindNearest(const glm::vec3 &point,
+                                         float maxDistance,
+                                         const EntityFilter &filter) const {
+  EntityHandle nearest;
+  float bestSquared = maxDistance * maxDistance;
+  m_SpatialTree.QuerySphere(point, maxDistance, [&](int32_t proxy) {
+    EntityHandle handle = ProxyEntity(proxy);
+    glm::vec3 position = glm::vec3(GetWorldTransform(handle)[3]);
+    glm::vec3 offset = position - point;
+    float distanceSquared = glm::dot(offset, offset);
+    if (distanceSquared <= bestSquared && (!filter || filter(handle))) {
+      bestSquared = distanceSquared;
+      nearest = handle;
+    }
+    return true;
+  });
+  return nearest;
+}
+
+glm::mat4 EntityRegistry::ComputeWorldTransform(EntityHandle handle) const {
+  glm::mat4 world = Get<Transform>(handle).GetTransform();
+  for (EntityHandle p = GetParent(handle); p.IsValid(); p = GetParent(p))
+    world = Get<Transform>(p).GetTransform() * world;
+  return world;
+}
+
+Transform EntityRegistry::GetWorldPose(EntityHandle handle) const {
+  if (!GetParent(handle).IsValid())
+    return Get<Transform>(handle);
+  return Transform::FromMatrix(GetWorldTransform(handle));
+}
+
+void EntityRegistry::SaveSnapshot(Snapshot &snapshot) const {
+  snapshot.Entities = m_Dense;
+  snapshot.Handles = m_DenseHandles;
+  snapshot.Names.resize(m_Dense.size());
+  snapshot.CameraFOVs.resize(m_Dense.size());
+  for (size_t i = 0; i < m_Dense.size(); i++) {
+    snapshot.Names[i] = m_Dense[i]->Name;
+    snapshot.CameraFOVs[i] = m_Dense[i]->CameraFOV;
+  }
+
+  std::apply(
+      [&snapshot](const auto &...pools) {
+        (pools.CopyTo(std::get<std::vector<
+                          typename std::decay_t<decltype(pools)>::ValueType>>(
+             snapshot.Components)),
+         ...);
+      },
+      m_Pools);
+}
+
+void EntityRegistry::RestoreSnapshot(const Snapshot &snapshot) {
+  // Members added since the snapshot leave the scene. They are released
+  // last, once the registry is consistent again.
+  std::vector<Ref<Entity>> previous;
+  previous.swap(m_Dense);
+  for (EntityHandle handle : m_DenseHandles)
+    m_Sparse[handle.GetIndex()] = NOT_PRESENT;
+
+  auto restore = [&snapshot](auto &pool) {
+    using T = typename std::decay_t<decltype(pool)>::ValueType;
+    const std::vector<T> &saved = std::get<std::vector<T>>(snapshot.Components);
+    if constexpr (std::is_same_v<T, ScriptComponent>) {
+      // Native instances are live objects, not data; keep the current ones
+      for (EntityHandle handle : snapshot.Handles)
+        pool[handle.GetIndex()].LuaScripts = saved[handle.GetIndex()].LuaScripts;
+    } else {
+      pool.CopyFrom(saved);
+    }
+  };
+  std::apply([&restore](auto &...pools) { (restore(pools), ...); }, m_Pools);
+
+  m_Dense = snapshot.Entities;
+  m_DenseHandles = snapshot.Handles;
+  ReindexFrom(0);
+  for (size_t i = 0; i < m_Dense.size(); i++) {
+    m_Dense[i]->Name = snapshot.Names[i];
+    m_Dense[i]->CameraFOV = snapshot.CameraFOVs[i];
+  }
+
+  // Tag ids are re-interned from scratch; masks are rebuilt with them
+  m_NameIndex.clear();
+  m_TagIds.clear();
+  m_TagMembers.clear();
+  for (EntityHandle handle : m_DenseHandles)
+    IndexEntity(handle);
+  m_HierarchyDirty = true;
+
+  // Proxy ids in the restored pool belong to the old tree; members rejoin it
+  // on the next UpdateWorldTransforms()
+  m_SpatialTree.Clear();
+  ForEachSlot<BoundsComponent>(
+      [](BoundsComponent &bounds) { bounds.Proxy = AABBTree::NULL_NODE; });
+}
+
+void EntityRegistry::IndexEntity(EntityHandle handle) {
+  Ref<Entity> entity = Find(handle);
+  m_NameIndex[entity->Name].push_back(handle);
+
+  TagComponent &tags = Get<TagComponent>(handle);
+  tags.Mask = 0;
+  for (const auto &tag : tags.Tags)
+    IndexTag(handle, tag);
+}
+
+void EntityRegistry::UnindexEntity(EntityHandle handle) {
+  Ref<Entity> entity = Find(handle);
+  auto it = m_NameIndex.find(entity->Name);
+  if (it != m_NameIndex.end()) {
+    EraseHandle(it->second, handle);
+    if (it->second.empty())
+      m_NameIndex.erase(it);
+  }
+
+  for (const auto &tag : Get<TagComponent>(handle).Tags)
+    UnindexTag(handle, tag);
+}
+
+void EntityRegistry::IndexTag(EntityHandle handle, const std::string &tag) {
+  auto [it, inserted] =
+      m_TagIds.try_emplace(tag, static_cast<uint32_t>(m_TagMembers.size()));
+  if (inserted)
+    m_TagMembers.emplace_back();
+
+  uint32_t id = it->second;
+  auto &members = m_TagMembers[id];
+  if (std::find(members.begin(), members.end(), handle) == members.end())
+    members.push_back(handle);
+  if (id < 64)
+    Get<TagComponent>(handle).Mask |= uint64_t(1) << id;
+}
+
+void EntityRegistry::UnindexTag(EntityHandle handle, const std::string &tag) {
+  auto it = m_TagIds.find(tag);
+  if (it == m_TagIds.end())
+    return;
+
+  // Interned ids are kept until Clear() so masks never need renumbering
+  EraseHandle(m_TagMembers[it->second], handle);
+  if (it->second < 64)
+    Get<TagComponent>(handle).Mask &= ~(uint64_t(1) << it->second);
+}
+
+void EntityRegistry::EraseHandle(std::vector<EntityHandle> &list,
+                                 EntityHandle handle) {
+  auto it = std::find(list.begin(), list.end(), handle);
+  if (it != list.end())
+    list.erase(it);
+}
+
+} // namespace S67
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "Core/Base.h"
+#include "Renderer/Components.h"
+#include "Renderer/EntityHandle.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace S67 {
+
+class Entity;
+
+/**
+ * @brief Paged component array addressed by registry slot
+ *
+ * Pages are never moved once allocated, so references handed out to Entity
+ * façades stay valid while other entities are created, and components of
+ * entities created together sit next to each other in memory.
+ */
+template <typename T> class ComponentPool {
+public:
+  using ValueType = T;
+  static constexpr uint32_t PAGE_SIZE = 256;
+
+  T &operator[](uint32_t slot) {
+    return m_Pages[slot / PAGE_SIZE][slot % PAGE_SIZE];
+  }
+  const T &operator[](uint32_t slot) const {
+    return m_Pages[slot / PAGE_SIZE][slot % PAGE_SIZE];
+  }
+
+  void EnsureSlot(uint32_t slot) {
+    while (m_Pages.size() * PAGE_SIZE <= slot)
+      m_Pages.push_back(std::make_unique<T[]>(PAGE_SIZE));
+  }
+  void ResetSlot(uint32_t slot) { (*this)[slot] = T(); }
+
+  // Whole-page copies for snapshots; for trivially copyable components each
+  // page is a single memmove
+  void CopyTo(std::vector<T> &out) const {
+    out.resize(m_Pages.size() * PAGE_SIZE);
+    for (size_t page = 0; page < m_Pages.size(); page++)
+      std::copy_n(m_Pages[page].get(), PAGE_SIZE,
+                  out.data() + page * PAGE_SIZE);
+  }
+  // Pages allocated after the copy was taken are left alone
+  void CopyFrom(const std::vector<T> &in) {
+    size_t pages = std::min(m_Pages.size(), in.size() / PAGE_SIZE);
+    for (size_t page = 0; page < pages; page++)
+      std::copy_n(in.data() + page * PAGE_SIZE, PAGE_SIZE,
+                  m_Pages[page].get());
+  }
+
+private:
+  std::vector<std::unique_ptr<T[]>> m_Pages;
+};
+
+/**
+ * @brief Sparse-set entity registry backing a Scene
+ *
+ * Owns the component data of every entity it created, one packed pool per
+ * component type, indexed by the handle's slot. Scene membership is a sparse
+ * set on top of that: a dense, ordered array of member entities (and their
+ * handles, for loops that only touch components) plus a slot -> dense
+ * position table for O(1) lookup. Removal keeps scene order, which is what
+ * the hierarchy panel shows and levels are saved in, so it is an ordered
+ * erase: O(n) in the members after the removed one.
+ *
+ * Members are also indexed by name and by interned tag. Entity::Name and
+ * Entity::Tags are plain data, so anything that changes them on a member
+ * must go through Rename()/AddTag()/RemoveTag() to keep the indexes right.
+ *
+ * Members can be parented to each other with SetParent(). The registry keeps
+ * a topological order of the forest (parents before children, roots in scene
+ * order) that UpdateWorldTransforms() walks.
+ */
+class EntityRegistry {
+  template <typename... Components> struct Storage {
+    using Pools = std::tuple<ComponentPool<Components>...>;
+    using Copies = std::tuple<std::vector<Components>...>;
+  };
+  using ComponentStorage =
+      Storage<Transform, MeshRendererComponent, PhysicsBodyComponent,
+              ScriptComponent, TagComponent, MovementSettings,
+              WorldTransformComponent, HierarchyComponent, BoundsComponent,
+              PrefabComponent>;
+
+public:
+  // Every member and all component data, as taken by SaveSnapshot()
+  struct Snapshot {
+    std::vector<Ref<Entity>> Entities; // Keeps members deleted since alive
+    std::vector<EntityHandle> Handles;
+    std::vector<std::string> Names;
+    std::vector<float> CameraFOVs;
+    ComponentStorage::Copies Components; // Slot-indexed page copies
+
+    bool IsEmpty() const { return Handles.empty(); }
+    void Clear() { *this = Snapshot(); }
+  };
+
+  EntityRegistry() = default;
+  EntityRegistry(const EntityRegistry &) = delete;
+  EntityRegistry &operator=(const EntityRegistry &) = delete;
+
+  // Slot lifetime (driven by the Entity façade's constructor/destructor)
+  EntityHandle Create();
+  void Destroy(EntityHandle handle);
+  bool IsAlive(EntityHandle handle) const;
+
+  template <typename T> T &Get(EntityHandle handle) {
+    return std::get<ComponentPool<T>>(m_Pools)[handle.GetIndex()];
+  }
+  template <typename T> const T &Get(EntityHandle handle) const {
+    return std::get<ComponentPool<T>>(m_Pools)[handle.GetIndex()];
+  }
+
+  // Visits the component of every allocated slot, members or not
+  template <typename T, typename Func> void ForEachSlot(Func &&func) {
+    auto &pool = std::get<ComponentPool<T>>(m_Pools);
+    for (uint32_t slot = 0; slot < m_Generations.size(); slot++)
+      func(pool[slot]);
+  }
+
+  // Scene membership, in scene order
+  void Add(const Ref<Entity> &entity);
+  void Insert(size_t position, const Ref<Entity> &entity);
+  void Remove(EntityHandle handle);
+  void Clear();
+  bool Contains(EntityHandle handle) const;
+  Ref<Entity> Find(EntityHandle handle) const;
+
+  // Name / tag indexes (members only)
+  Ref<Entity> FindByName(const std::string &name) const;
+  void Rename(EntityHandle handle, const std::string &name);
+  bool HasTag(EntityHandle handle, const std::string &tag) const;
+  bool AddTag(EntityHandle handle, const std::string &tag);
+  void RemoveTag(EntityHandle handle, const std::string &tag);
+  const std::vector<EntityHandle> &GetTagged(const std::string &tag) const;
+
+  // Hierarchy (members only). SetParent fails if it would form a cycle; an
+  // invalid parent makes the entity a root again. The child's Transform is
+  // left as is, so it is now read relative to the new parent.
+  bool SetParent(EntityHandle child, EntityHandle parent);
+  EntityHandle GetParent(EntityHandle handle) const {
+    return Get<HierarchyComponent>(handle).Parent;
+  }
+  const std::vector<EntityHandle> &GetChildren(EntityHandle handle) const {
+    return Get<HierarchyComponent>(handle).Children;
+  }
+  bool IsAncestor(EntityHandle ancestor, EntityHandle handle) const;
+
+  // Rebuilds the cached world matrix of every member whose Transform changed
+  // since it was last built, and of everything below it. Changed handles are
+  // appended to changed if given, parents before children. Change detection
+  // compares values, so direct writes to entity->Transform (inspector, gizmo,
+  // scripts, physics sync) are caught.
+  size_t UpdateWorldTransforms(std::vector<EntityHandle> *changed = nullptr);
+  const glm::mat4 &GetWorldTransform(EntityHandle handle) const {
+    return Get<WorldTransformComponent>(handle).World;
+  }
+  // World matrix straight from the Transforms up the parent chain, for when
+  // the cache may be stale
+  glm::mat4 ComputeWorldTransform(EntityHandle handle) const;
+  // Cached world placement as a Transform: the entity's own for roots, the
+  // decomposed world matrix for children
+  Transform GetWorldPose(EntityHandle handle) const;
+  void MarkTransformDirty(EntityHandle handle) {
+    Get<WorldTransformComponent>(handle).Valid = false;
+  }
+
+  // Spatial index over members' world bounds, kept in step by
+  // UpdateWorldTransforms(), so queries see the scene as of the last update.
+  // A member's local box is its mesh's bounds, picked up whenever the mesh
+  // changes; SetLocalBounds() overrides it until the next change.
+  // Box, sphere and frustum results are exact against each entity's world
+  // AABB; Raycast tests the entity's oriented box and returns the nearest
+  // hit. The filter, if given, can veto candidates.
+  using EntityFilter = std::function<bool(EntityHandle)>;
+  void SetLocalBounds(EntityHandle handle, const AABB &bounds);
+  const AABB &GetWorldBounds(EntityHandle handle) const {
+    return Get<BoundsComponent>(handle).World;
+  }
+  void QueryBox(const AABB &box, std::vector<EntityHandle> &out) const;
+  void QuerySphere(const glm::vec3 &center, float radius,
+                   std::vector<EntityHandle> &out) const;
+  void QueryFrustum(const Frustum &frustum,
+                    std::vector<EntityHandle> &out) const;
+  EntityHandle Raycast(const glm::vec3 &origin, const glm::vec3 &direction,
+                       float maxDistance, float *hitDistance = nullptr,
+                       const EntityFilter &filter = nullptr) const;
+  // Member whose origin is closest to point, within maxDistance
+  EntityHandle FindNearest(const glm::vec3 &point, float maxDistance,
+                           const EntityFilter &filter = nullptr) const;
+  const AABBTree &GetSpatialTree() const { return m_SpatialTree; }
+
+  // Play-mode backup. RestoreSnapshot() brings back membership, order and
+  // every component, then rebuilds the indexes. Native script instances are
+  // live objects and stay as they are; Lua scripts go back to their saved
+  // (normally not yet initialized) state. Members added since the snapshot
+  // are dropped from the scene.
+  void SaveSnapshot(Snapshot &snapshot) const;
+  void RestoreSnapshot(const Snapshot &snapshot);
+
+  size_t Size() const { return m_Dense.size(); }
+  const std::vector<Ref<Entity>> &GetEntities() const { return m_Dense; }
+  const std::vector<EntityHandle> &GetHandles() const {
+    return m_DenseHandles;
+  }
+
+private:
+  static constexpr uint32_t NOT_PRESENT = 0xFFFFFFFF;
+
+  void ReindexFrom(size_t position);
+  void RebuildHierarchyOrder();
+  void Detach(EntityHandle handle);
+  void UpdateBounds(uint32_t slot, const glm::mat4 &world);
+  static bool SyncLocalBounds(BoundsComponent &bounds,
+                              const Ref<VertexArray> &mesh);
+  EntityHandle ProxyEntity(int32_t proxy) const {
+    return EntityHandle::FromValue(m_SpatialTree.GetUserData(proxy));
+  }
+  void IndexEntity(EntityHandle handle);
+  void UnindexEntity(EntityHandle handle);
+  void IndexTag(EntityHandle handle, const std::string &tag);
+  void UnindexTag(EntityHandle handle, const std::string &tag);
+  static void EraseHandle(std::vector<EntityHandle> &list, EntityHandle handle);
+
+  std::vector<uint32_t> m_Generations; // Per slot
+  std::vector<uint32_t> m_FreeSlots;
+  std::vector<uint32_t> m_Sparse;      // Slot -> dense position
+  std::vector<Ref<Entity>> m_Dense;
+  std::vector<EntityHandle> m_DenseHandles;
+
+  std::unordered_map<std::string, std::vector<EntityHandle>> m_NameIndex;
+  std::unordered_map<std::string, uint32_t> m_TagIds; // Interned tags
+  std::vector<std::vector<EntityHandle>> m_TagMembers; // Per tag id
+
+  std::vector<uint32_t> m_HierarchyOrder; // Member slots, parents first
+  bool m_HierarchyDirty = false;
+  std::vector<uint32_t> m_DirtyScratch;
+  uint32_t m_WorldStamp = 0;
+  AABBTree m_SpatialTree;
+
+  ComponentStorage::Pools m_Pools;
+};
+
+} // namespace S67
@@ -0,0 +1,113 @@
+#include "FrustumCuller.h"
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                   \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define S67_CULL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define S67_CULL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace S67 {
+
+void FrustumCuller::Add(const AABB &box) {
+  if (m_Count == m_CenterX.size()) {
+    // Grow a whole group at a time so the SIMD loop never reads past the end
+    size_t size = m_Count + 4;
+    for (auto *lane : {&m_CenterX, &m_CenterY, &m_CenterZ, &m_ExtentX,
+                       &m_ExtentY, &m_ExtentZ})
+      lane->resize(size, 0.0f);
+  }
+
+  glm::vec3 center = box.GetCenter();
+  glm::vec3 extents = box.GetExtents();
+  m_CenterX[m_Count] = center.x;
+  m_CenterY[m_Count] = center.y;
+  m_CenterZ[m_Count] = center.z;
+  m_ExtentX[m_Count] = extents.x;
+  m_ExtentY[m_Count] = extents.y;
+  m_ExtentZ[m_Count] = extents.z;
+  m_Count++;
+}
+
+void FrustumCuller::Cull(const Frustum &frustum,
+                         std::vector<uint8_t> &visible) const {
+  visible.resize(m_Count);
+
+  // A box is outside a plane when its center's distance plus its projected
+  // radius is negative; it is culled if that holds for any plane
+#if defined(S67_CULL_SSE2)
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  for (size_t i = 0; i < m_Count; i += 4) {
+    __m128 cx = _mm_loadu_ps(&m_CenterX[i]);
+    __m128 cy = _mm_loadu_ps(&m_CenterY[i]);
+    __m128 cz = _mm_loadu_ps(&m_CenterZ[i]);
+    __m128 ex = _mm_loadu_ps(&m_ExtentX[i]);
+    __m128 ey = _mm_loadu_ps(&m_ExtentY[i]);
+    __m128 ez = _mm_loadu_ps(&m_ExtentZ[i]);
+
+    __m128 outside = _mm_setzero_ps();
+    for (const glm::vec4 &plane : frustum.Planes) {
+      __m128 nx = _mm_set1_ps(plane.x);
+      __m128 ny = _mm_set1_ps(plane.y);
+      __m128 nz = _mm_set1_ps(plane.z);
+      __m128 distance = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(cx, nx), _mm_mul_ps(cy, ny)),
+          _mm_add_ps(_mm_mul_ps(cz, nz), _mm_set1_ps(plane.w)));
+      __m128 radius = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(ex, _mm_andnot_ps(signMask, nx)),
+                     _mm_mul_ps(ey, _mm_andnot_ps(signMask, ny))),
+          _mm_mul_ps(ez, _mm_andnot_ps(signMask, nz)));
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius),
+                                                _mm_setzero_ps()));
+    }
+
+    int mask = _mm_movemask_ps(outside);
+    for (size_t lane = 0; lane < 4 && i + lane < m_Count; lane++)
+      visible[i + lane] = (mask >> lane & 1) ? 0 : 1;
+  }
+#elif defined(S67_CULL_NEON)
+  for (size_t i = 0; i < m_Count; i += 4) {
+    float32x4_t cx = vld1q_f32(&m_CenterX[i]);
+    float32x4_t cy = vld1q_f32(&m_CenterY[i]);
+    float32x4_t cz = vld1q_f32(&m_CenterZ[i]);
+    float32x4_t ex = vld1q_f32(&m_ExtentX[i]);
+    float32x4_t ey = vld1q_f32(&m_ExtentY[i]);
+    float32x4_t ez = vld1q_f32(&m_ExtentZ[i]);
+
+    uint32x4_t outside = vdupq_n_u32(0);
+    for (const glm::vec4 &plane : frustum.Planes) {
+      float32x4_t distance = vdupq_n_f32(plane.w);
+      distance = vmlaq_n_f32(distance, cx, plane.x);
+      distance = vmlaq_n_f32(distance, cy, plane.y);
+      distance = vmlaq_n_f32(distance, cz, plane.z);
+      float32x4_t radius = vmulq_n_f32(ex, std::abs(plane.x));
+      radius = vmlaq_n_f32(radius, ey, std::abs(plane.y));
+      radius = vmlaq_n_f32(radius, ez, std::abs(plane.z));
+      outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius),
+                                             vdupq_n_f32(0.0f)));
+    }
+
+    uint32_t lanes[4];
+    vst1q_u32(lanes, outside);
+    for (size_t lane = 0; lane < 4 && i + lane < m_Count; lane++)
+      visible[i + lane] = lanes[lane] ? 0 : 1;
+  }
+#else
+  for (size_t i = 0; i < m_Count; i++) {
+    bool outside = false;
+    for (const glm::vec4 &plane : frustum.Planes) {
+      float distance = m_CenterX[i] * plane.x + m_CenterY[i] * plane.y +
+                       m_CenterZ[i] * plane.z + plane.w;
+      float radius = m_ExtentX[i] * std::abs(plane.x) +
+                     m_ExtentY[i] * std::abs(plane.y) +
+                     m_ExtentZ[i] * std::abs(plane.z);
+      outside |= distance + radius < 0.0f;
+    }
+    visible[i] = outside ? 0 : 1;
+  }
+#endif
+}
+
+} // namespace S67
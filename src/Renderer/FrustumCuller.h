@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Renderer/Bounds.h"
+#include <cstdint>
+#include <vector>
+
+namespace S67 {
+
+/**
+ * @brief Tests a frame's world bounds against view frusta, four at a time
+ *
+ * Boxes are kept as centers and extents in separate arrays (padded to a
+ * multiple of four) so each frustum plane is tested against four boxes with
+ * one SSE2 or NEON instruction per term; other targets fall back to the same
+ * test in scalar code. Fill the culler once per frame and cull it once per
+ * camera. A box is kept if it is at least partly inside every plane, which
+ * can keep a few boxes near the frustum's corners but never drops a visible
+ * one.
+ */
+class FrustumCuller {
+public:
+  void Clear() { m_Count = 0; }
+  // Boxes are indexed in the order they are added
+  void Add(const AABB &box);
+  void Add(const AABB &localBox, const glm::mat4 &transform) {
+    Add(localBox.Transformed(transform));
+  }
+  size_t GetCount() const { return m_Count; }
+
+  // Resizes visible to GetCount(); an entry is 1 if that box may be seen
+  void Cull(const Frustum &frustum, std::vector<uint8_t> &visible) const;
+
+private:
+  size_t m_Count = 0;
+  std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+  std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+};
+
+} // namespace S67
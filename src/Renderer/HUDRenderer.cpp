@@ -1,6 +1,7 @@
 #include "HUDRenderer.h"
 #include "Core/Logger.h"
 #include "Renderer/Buffer.h"
+#include <algorithm>
 #include <cstring>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -113,43 +114,45 @@ static const unsigned char s_Font8x8[96][8] = {
 
 HUDRenderer::HUDData *HUDRenderer::s_Data = nullptr;
 
+// Font atlas: 96 8x8 glyphs in a 16x6 grid, plus a solid cell in the corner
+// for untextured quads, sampled at its center so filtering can't reach a
+// glyph
+static constexpr uint32_t ATLAS_WIDTH = 128;
+static constexpr uint32_t ATLAS_HEIGHT = 64;
+static const glm::vec2 s_SolidTexCoord = {124.0f / ATLAS_WIDTH,
+                                          60.0f / ATLAS_HEIGHT};
+
 void HUDRenderer::Init() {
   s_Data = new HUDData();
 
-  // Create quad vertex array for rendering UI elements
-  // 2D quad: position (x, y) + texcoord (u, v)
-  float quadVertices[] = {
-      // positions    // texcoords
-      0.0f, 0.0f, 0.0f, 0.0f, // bottom-left
-      1.0f, 0.0f, 1.0f, 0.0f, // bottom-right
-      1.0f, 1.0f, 1.0f, 1.0f, // top-right
-      0.0f, 1.0f, 0.0f, 1.0f  // top-left
-  };
-
-  uint32_t quadIndices[] = {
-      0, 1, 2, // first triangle
-      2, 3, 0  // second triangle
-  };
-
-  s_Data->QuadVAO = VertexArray::Create();
-
-  Ref<VertexBuffer> quadVBO =
-      VertexBuffer::Create(quadVertices, sizeof(quadVertices));
-  quadVBO->SetLayout({{ShaderDataType::Float2, "a_Position"},
-                      {ShaderDataType::Float2, "a_TexCoord"}});
-  s_Data->QuadVAO->AddVertexBuffer(quadVBO);
-
-  Ref<IndexBuffer> quadIBO =
-      IndexBuffer::Create(quadIndices, sizeof(quadIndices) / sizeof(uint32_t));
-  s_Data->QuadVAO->SetIndexBuffer(quadIBO);
-
-  // Create Font Texture Atlas (12 characters wide, 8 characters high = 96
-  // characters) Each character is 8x8 pixels. Total texture size: 96x8 pixels
-  // in a strip. Actually let's make it 128x64 for alignment reasons.
-  uint32_t atlasWidth = 128;
-  uint32_t atlasHeight = 64;
-  unsigned char *atlasPixels = new unsigned char[atlasWidth * atlasHeight];
-  memset(atlasPixels, 0, atlasWidth * atlasHeight);
+  // Streaming quads: position (x, y), texcoord (u, v), color (rgba). The
+  // index buffer is fixed, since every quad is two triangles over its own
+  // four vertices.
+  s_Data->BatchVAO = VertexArray::Create();
+  s_Data->BatchVBO =
+      VertexBuffer::Create(MAX_QUADS * 4 * (uint32_t)sizeof(HUDVertex));
+  s_Data->BatchVBO->SetLayout({{ShaderDataType::Float2, "a_Position"},
+                               {ShaderDataType::Float2, "a_TexCoord"},
+                               {ShaderDataType::Float4, "a_Color"}});
+  s_Data->BatchVAO->AddVertexBuffer(s_Data->BatchVBO);
+
+  std::vector<uint32_t> indices(MAX_QUADS * 6);
+  for (uint32_t quad = 0; quad < MAX_QUADS; quad++) {
+    uint32_t first = quad * 4;
+    uint32_t *out = &indices[quad * 6];
+    out[0] = first + 0; // bottom-left, bottom-right, top-right
+    out[1] = first + 1;
+    out[2] = first + 2;
+    out[3] = first + 2; // top-right, top-left, bottom-left
+    out[4] = first + 3;
+    out[5] = first + 0;
+  }
+  s_Data->BatchVAO->SetIndexBuffer(
+      IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+  s_Data->Batch.reserve(MAX_QUADS * 4);
+
+  unsigned char *atlasPixels = new unsigned char[ATLAS_WIDTH * ATLAS_HEIGHT];
+  memset(atlasPixels, 0, ATLAS_WIDTH * ATLAS_HEIGHT);
 
   for (int i = 0; i < 96; i++) {
     int charX = (i % 16) * 8;
@@ -159,15 +162,17 @@ void HUDRenderer::Init() {
         if (s_Font8x8[i][y] & (1 << (7 - x))) {
           // Flip Y: atlasPixels expects bottom-to-top, but source data is
           // top-to-bottom
-          atlasPixels[(charY + (7 - y)) * atlasWidth + (charX + x)] = 255;
+          atlasPixels[(charY + (7 - y)) * ATLAS_WIDTH + (charX + x)] = 255;
         }
       }
     }
   }
+  for (uint32_t y = ATLAS_HEIGHT - 8; y < ATLAS_HEIGHT; y++)
+    memset(&atlasPixels[y * ATLAS_WIDTH + ATLAS_WIDTH - 8], 255, 8);
 
   glGenTextures(1, &s_Data->FontTextureID);
   glBindTexture(GL_TEXTURE_2D, s_Data->FontTextureID);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasWidth, atlasHeight, 0, GL_RED,
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RED,
                GL_UNSIGNED_BYTE, atlasPixels);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -182,6 +187,12 @@ void HUDRenderer::Init() {
 void HUDRenderer::SetShader(const Ref<Shader> &shader) {
   if (s_Data) {
     s_Data->HUDShader = shader;
+    s_Data->HUDUniforms = HUDData::Uniforms();
+    if (shader) {
+      auto &uniforms = s_Data->HUDUniforms;
+      uniforms.Projection = shader->GetUniform<glm::mat4>("u_Projection");
+      uniforms.Texture = shader->GetUniform<int>("u_Texture");
+    }
   }
 }
 
@@ -203,6 +214,8 @@ void HUDRenderer::BeginHUD(float width, float height) {
   s_Data->ViewportHeight = height;
 
   s_Data->ProjectionMatrix = glm::ortho(0.0f, width, 0.0f, height, -1.0f, 1.0f);
+  s_Data->Batch.clear();
+  s_Data->Stats = Statistics();
 
   glDisable(GL_DEPTH_TEST);
   glEnable(GL_BLEND);
@@ -218,26 +231,39 @@ void HUDRenderer::EndHUD() {
   float scale = 3.0f;
   float charWidth = 8.0f * scale;
 
-  for (auto &queued : s_Data->TextQueue) {
-    float textWidth = queued.Text.length() * charWidth;
-    glm::vec2 pos = {(s_Data->ViewportWidth - textWidth) * 0.5f,
-                     s_Data->ViewportHeight - yOffset};
-    DrawString(queued.Text, pos, scale, queued.Color);
-    yOffset += 40.0f; // Move down for next line
-  }
+  {
+    std::lock_guard<std::mutex> lock(s_Data->TextMutex);
+    for (auto &queued : s_Data->TextQueue) {
+      float textWidth = queued.Text.length() * charWidth;
+      glm::vec2 pos = {(s_Data->ViewportWidth - textWidth) * 0.5f,
+                       s_Data->ViewportHeight - yOffset};
+      DrawString(queued.Text, pos, scale, queued.Color);
+      yOffset += 40.0f; // Move down for next line
+    }
 
-  // Render Persistent Texts
-  for (auto const &[id, pt] : s_Data->PersistentTexts) {
-    float charW = 8.0f * pt.Scale;
-    float textW = pt.Text.length() * charW;
-    // Position is normalized 0-1
-    glm::vec2 screenPos = {
-        (s_Data->ViewportWidth * pt.Position.x) - (textW * 0.5f),
-        s_Data->ViewportHeight * pt.Position.y};
-    DrawString(pt.Text, screenPos, pt.Scale, pt.Color);
+    // Persistent texts are only laid out again when they or the viewport
+    // change
+    glm::vec2 viewport(s_Data->ViewportWidth, s_Data->ViewportHeight);
+    for (auto &entry : s_Data->PersistentTexts) {
+      HUDData::PersistentText &pt = entry.second;
+      if (pt.LayoutViewport != viewport) {
+        float charW = 8.0f * pt.Scale;
+        float textW = pt.Text.length() * charW;
+        // Position is normalized 0-1
+        glm::vec2 screenPos = {(viewport.x * pt.Position.x) - (textW * 0.5f),
+                               viewport.y * pt.Position.y};
+        pt.Layout.clear();
+        LayoutString(pt.Text, screenPos, pt.Scale, pt.Color, pt.Layout);
+        pt.LayoutViewport = viewport;
+      }
+      AddQuads(pt.Layout.data(), pt.Layout.size());
+    }
+
+    s_Data->TextQueue.clear();
   }
 
-  s_Data->TextQueue.clear();
+  Flush();
+  s_Data->LastStats = s_Data->Stats;
 
   glEnable(GL_DEPTH_TEST);
 }
@@ -291,6 +317,7 @@ void HUDRenderer::RenderSpeed(float speed) {
 
 void HUDRenderer::QueueString(const std::string &text, const glm::vec4 &color) {
   if (s_Data) {
+    std::lock_guard<std::mutex> lock(s_Data->TextMutex);
     s_Data->TextQueue.push_back({text, color});
   }
 }
@@ -299,30 +326,46 @@ void HUDRenderer::SetText(const std::string &id, const std::string &text,
                           const glm::vec2 &position, float scale,
                           const glm::vec4 &color) {
   if (s_Data) {
-    s_Data->PersistentTexts[id] = {text, position, scale, color};
+    std::lock_guard<std::mutex> lock(s_Data->TextMutex);
+    auto [it, inserted] = s_Data->PersistentTexts.try_emplace(id);
+    HUDData::PersistentText &pt = it->second;
+    // Scripts tend to set the same text every tick; that keeps its layout
+    if (!inserted && pt.Text == text && pt.Position == position &&
+        pt.Scale == scale && pt.Color == color)
+      return;
+    pt.Text = text;
+    pt.Position = position;
+    pt.Scale = scale;
+    pt.Color = color;
+    pt.LayoutViewport = glm::vec2(-1.0f);
   }
 }
 
 void HUDRenderer::ClearText(const std::string &id) {
   if (s_Data) {
+    std::lock_guard<std::mutex> lock(s_Data->TextMutex);
     s_Data->PersistentTexts.erase(id);
   }
 }
 
 void HUDRenderer::DrawString(const std::string &text, const glm::vec2 &position,
                              float scale, const glm::vec4 &color) {
-  if (!s_Data || !s_Data->HUDShader || !s_Data->FontTextureID)
+  if (!s_Data)
     return;
 
-  s_Data->HUDShader->Bind();
-  s_Data->HUDShader->SetMat4("u_Projection", s_Data->ProjectionMatrix);
-  s_Data->HUDShader->SetFloat4("u_Color", color);
-  s_Data->HUDShader->SetInt("u_UseTexture", 1);
+  s_Data->Scratch.clear();
+  LayoutString(text, position, scale, color, s_Data->Scratch);
+  AddQuads(s_Data->Scratch.data(), s_Data->Scratch.size());
+}
 
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, s_Data->FontTextureID);
-  s_Data->HUDShader->SetInt("u_Texture", 0);
+HUDRenderer::Statistics HUDRenderer::GetStatistics() {
+  return s_Data ? s_Data->LastStats : Statistics();
+}
 
+void HUDRenderer::LayoutString(const std::string &text,
+                               const glm::vec2 &position, float scale,
+                               const glm::vec4 &color,
+                               std::vector<HUDVertex> &out) {
   glm::vec2 currentPos = position;
   float charSize = 8.0f * scale;
 
@@ -335,64 +378,73 @@ void HUDRenderer::DrawString(const std::string &text, const glm::vec2 &position,
     int charY = (index / 16);
 
     // UV coordinates in the atlas
-    float uStart = (charX * 8.0f) / 128.0f;
-    float vStart = (charY * 8.0f) / 64.0f;
-    float uEnd = uStart + (8.0f / 128.0f);
-    float vEnd = vStart + (8.0f / 64.0f);
-
-    // Using a custom transform matrix for each character
-    glm::mat4 transform =
-        glm::translate(glm::mat4(1.0f), glm::vec3(currentPos, 0.0f));
-    transform = glm::scale(transform, glm::vec3(charSize, charSize, 1.0f));
-    s_Data->HUDShader->SetMat4("u_Transform", transform);
-
-    // We need to update the UVs in the shader or use a separate VAO per
-    // character. For simplicity with the existing RenderQuad which assumes
-    // static UVs, let's just use a special RenderQuadInternal that takes UVs.
-
-    // Actually, I'll update the global QuadVAO's UVs or better:
-    // pass UVs as uniforms.
-    s_Data->HUDShader->SetFloat4("u_UVBounds",
-                                 glm::vec4(uStart, vStart, uEnd, vEnd));
-
-    s_Data->QuadVAO->Bind();
-    glDrawElements(GL_TRIANGLES, s_Data->QuadVAO->GetIndexBuffer()->GetCount(),
-                   GL_UNSIGNED_INT, nullptr);
+    float uStart = (charX * 8.0f) / ATLAS_WIDTH;
+    float vStart = (charY * 8.0f) / ATLAS_HEIGHT;
+    float uEnd = uStart + (8.0f / ATLAS_WIDTH);
+    float vEnd = vStart + (8.0f / ATLAS_HEIGHT);
+
+    glm::vec2 max = currentPos + glm::vec2(charSize);
+    out.push_back({currentPos, {uStart, vStart}, color});
+    out.push_back({{max.x, currentPos.y}, {uEnd, vStart}, color});
+    out.push_back({max, {uEnd, vEnd}, color});
+    out.push_back({{currentPos.x, max.y}, {uStart, vEnd}, color});
 
     currentPos.x += charSize;
   }
-
-  s_Data->HUDShader->SetInt("u_UseTexture", 0);
 }
 
 void HUDRenderer::RenderQuad(const glm::vec2 &position, const glm::vec2 &size,
-                             const glm::vec4 &color, uint32_t textureID) {
-  if (!s_Data || !s_Data->HUDShader || !s_Data->QuadVAO)
+                             const glm::vec4 &color) {
+  if (!s_Data)
     return;
 
-  glm::mat4 transform =
-      glm::translate(glm::mat4(1.0f), glm::vec3(position, 0.0f));
-  transform = glm::scale(transform, glm::vec3(size, 1.0f));
+  glm::vec2 max = position + size;
+  HUDVertex quad[4] = {{position, s_SolidTexCoord, color},
+                       {{max.x, position.y}, s_SolidTexCoord, color},
+                       {max, s_SolidTexCoord, color},
+                       {{position.x, max.y}, s_SolidTexCoord, color}};
+  AddQuads(quad, 4);
+}
+
+void HUDRenderer::AddQuads(const HUDVertex *vertices, size_t count) {
+  auto &batch = s_Data->Batch;
+  while (count > 0) {
+    if (batch.size() == MAX_QUADS * 4)
+      Flush();
+    size_t room = MAX_QUADS * 4 - batch.size();
+    size_t taken = std::min(room, count);
+    batch.insert(batch.end(), vertices, vertices + taken);
+    vertices += taken;
+    count -= taken;
+  }
+}
+
+void HUDRenderer::Flush() {
+  auto &batch = s_Data->Batch;
+  if (batch.empty())
+    return;
 
-  s_Data->HUDShader->Bind();
-  s_Data->HUDShader->SetMat4("u_Projection", s_Data->ProjectionMatrix);
-  s_Data->HUDShader->SetMat4("u_Transform", transform);
-  s_Data->HUDShader->SetFloat4("u_Color", color);
+  if (s_Data->HUDShader && s_Data->HUDShader->IsValid() &&
+      s_Data->FontTextureID) {
+    Shader &shader = *s_Data->HUDShader;
+    const auto &uniforms = s_Data->HUDUniforms;
+    shader.Bind();
+    shader.Set(uniforms.Projection, s_Data->ProjectionMatrix);
 
-  if (textureID != 0) {
-    s_Data->HUDShader->SetInt("u_UseTexture", 1);
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    s_Data->HUDShader->SetInt("u_Texture", 0);
-    s_Data->HUDShader->SetFloat4("u_UVBounds",
-                                 glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
-  } else {
-    s_Data->HUDShader->SetInt("u_UseTexture", 0);
-  }
+    glBindTexture(GL_TEXTURE_2D, s_Data->FontTextureID);
+    shader.Set(uniforms.Texture, 0);
+
+    s_Data->BatchVBO->SetData(batch.data(),
+                              (uint32_t)(batch.size() * sizeof(HUDVertex)));
+    s_Data->BatchVAO->Bind();
+    uint32_t quads = (uint32_t)(batch.size() / 4);
+    glDrawElements(GL_TRIANGLES, quads * 6, GL_UNSIGNED_INT, nullptr);
 
-  s_Data->QuadVAO->Bind();
-  glDrawElements(GL_TRIANGLES, s_Data->QuadVAO->GetIndexBuffer()->GetCount(),
-                 GL_UNSIGNED_INT, nullptr);
+    s_Data->Stats.DrawCalls++;
+    s_Data->Stats.Quads += quads;
+  }
+  batch.clear();
 }
 
 } // namespace S67
@@ -6,13 +6,29 @@
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <map>
+#include <mutex>
 #include <string>
-
+#include <vector>
 
 namespace S67 {
 
+/**
+ * @brief Crosshair, speedometer and script text over the game view
+ *
+ * Everything drawn between BeginHUD() and EndHUD() is written as quads
+ * (position, atlas UV, color) into one streaming vertex buffer and drawn
+ * with a single call when EndHUD() flushes it, or earlier if the batch
+ * fills up. Solid quads sample a white cell of the font atlas, so text and
+ * shapes share the batch. Persistent texts from SetText() keep their laid
+ * out quads until the text, its placement or the viewport changes.
+ */
 class HUDRenderer {
 public:
+  struct Statistics {
+    uint32_t DrawCalls = 0;
+    uint32_t Quads = 0;
+  };
+
   static void Init();
   static void SetShader(const Ref<Shader> &shader);
   static void Shutdown();
@@ -35,17 +51,41 @@ public:
   static void DrawString(const std::string &text, const glm::vec2 &position,
                          float scale, const glm::vec4 &color);
 
+  // Counts for the last EndHUD()
+  static Statistics GetStatistics();
+
 private:
+  struct HUDVertex {
+    glm::vec2 Position; // Pixels, origin bottom-left
+    glm::vec2 TexCoord;
+    glm::vec4 Color;
+  };
+  static constexpr uint32_t MAX_QUADS = 4096; // Per draw
+
   static void RenderQuad(const glm::vec2 &position, const glm::vec2 &size,
-                         const glm::vec4 &color, uint32_t textureID = 0);
+                         const glm::vec4 &color);
+  static void LayoutString(const std::string &text, const glm::vec2 &position,
+                           float scale, const glm::vec4 &color,
+                           std::vector<HUDVertex> &out);
+  static void AddQuads(const HUDVertex *vertices, size_t count);
+  static void Flush();
 
   struct HUDData {
-    Ref<VertexArray> QuadVAO;
+    Ref<VertexArray> BatchVAO;
+    Ref<VertexBuffer> BatchVBO;
+    std::vector<HUDVertex> Batch; // Four vertices per quad
+    std::vector<HUDVertex> Scratch;
     Ref<Shader> HUDShader;
+    struct Uniforms {
+      UniformHandle<glm::mat4> Projection;
+      UniformHandle<int> Texture;
+    } HUDUniforms; // Resolved by SetShader()
     uint32_t FontTextureID = 0;
     glm::mat4 ProjectionMatrix;
     float ViewportWidth;
     float ViewportHeight;
+    Statistics Stats;     // Being counted
+    Statistics LastStats; // Of the last EndHUD()
 
     struct QueuedText {
       std::string Text;
@@ -58,8 +98,14 @@ private:
       glm::vec2 Position;
       float Scale;
       glm::vec4 Color;
+      // Quads as laid out for LayoutViewport
+      std::vector<HUDVertex> Layout;
+      glm::vec2 LayoutViewport = glm::vec2(-1.0f);
     };
     std::map<std::string, PersistentText> PersistentTexts;
+
+    // Scripts queue text from the simulation thread while EndHUD drains it
+    std::mutex TextMutex;
   };
 
   static HUDData *s_Data;
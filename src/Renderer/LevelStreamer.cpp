@@ -0,0 +1,432 @@
+#include "LevelStreamer.h"
+#include "Core/Application.h"
+#include "Core/Logger.h"
+#include "Core/Timer.h"
+#include "Game/Console/ConVar.h"
+#include "Renderer/TextureCache.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+
+namespace S67 {
+
+static ConVar stream_enable(
+    "stream_enable", "1", FCVAR_ARCHIVE,
+    "Stream level meshes and textures in around the cameras; 0 loads whole "
+    "levels up front and keeps everything resident");
+static ConVar stream_chunk_size("stream_chunk_size", "32", FCVAR_ARCHIVE,
+                                "Edge length of a streaming chunk", true,
+                                4.0f, false, 0.0f);
+static ConVar stream_radius(
+    "stream_radius", "128", FCVAR_ARCHIVE,
+    "Chunks closer than this to a camera are streamed in; they are dropped "
+    "again past 1.25x this distance",
+    true, 0.0f, false, 0.0f);
+static ConVar stream_upload_ms(
+    "stream_upload_ms", "2", FCVAR_ARCHIVE,
+    "Main-thread time per frame spent uploading streamed assets to the GPU "
+    "(at least one upload always goes through)",
+    true, 0.1f, false, 0.0f);
+
+static constexpr size_t MAX_WORKERS = 4;
+static constexpr size_t REBUCKET_PER_FRAME = 64;
+static constexpr float UNLOAD_HYSTERESIS = 1.25f;
+
+LevelStreamer::LevelStreamer() { m_ChunkSize = stream_chunk_size.GetFloat(); }
+
+LevelStreamer::~LevelStreamer() {
+  {
+    std::lock_guard<std::mutex> lock(m_JobMutex);
+    m_Stopping = true;
+  }
+  m_JobCondition.notify_all();
+  for (std::thread &worker : m_Workers)
+    worker.join();
+}
+
+void LevelStreamer::StartWorkers() {
+  // Leave the main and simulation threads a core each
+  unsigned cores = std::thread::hardware_concurrency();
+  size_t count = std::clamp<size_t>(cores > 2 ? cores - 2 : 1, 1, MAX_WORKERS);
+  for (size_t i = 0; i < count; i++)
+    m_Workers.emplace_back(&LevelStreamer::WorkerMain, this);
+}
+
+void LevelStreamer::WorkerMain() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(m_JobMutex);
+      m_JobCondition.wait(lock,
+                          [this] { return m_Stopping || !m_Jobs.empty(); });
+      if (m_Stopping)
+        return;
+      job = std::move(m_Jobs.front());
+      m_Jobs.pop_front();
+    }
+
+    Result result;
+    result.Type = job.Type;
+    result.Path = std::move(job.Path);
+    result.Generation = job.Generation;
+    if (job.Type == AssetType::Texture)
+      result.Success = Texture2D::LoadData(result.Path, result.Texture);
+    else if (std::filesystem::path(result.Path).extension() == ".stl")
+      result.Success = MeshLoader::ParseSTL(result.Path, result.Mesh);
+    else
+      result.Success = MeshLoader::ParseOBJ(result.Path, result.Mesh);
+
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    m_Results.push_back(std::move(result));
+  }
+}
+
+void LevelStreamer::Reset(Scene *scene) {
+  m_Scene = scene;
+  m_Generation++;
+  {
+    std::lock_guard<std::mutex> lock(m_JobMutex);
+    m_Jobs.clear();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    m_Results.clear();
+  }
+
+  m_ResolvedPaths.clear();
+  m_WaitingMeshes.clear();
+  m_WaitingTextures.clear();
+  m_ResidentMeshes.clear();
+  m_Resync = false;
+  m_Statistics = {};
+  Rebuild();
+}
+
+bool LevelStreamer::IsEnabled() { return stream_enable.GetBool(); }
+
+int64_t LevelStreamer::GetChunkKey(const glm::vec3 &position) const {
+  int32_t x = static_cast<int32_t>(std::floor(position.x / m_ChunkSize));
+  int32_t z = static_cast<int32_t>(std::floor(position.z / m_ChunkSize));
+  return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(z);
+}
+
+bool LevelStreamer::IsStreamedMesh(const std::string &meshPath) {
+  std::filesystem::path extension = std::filesystem::path(meshPath).extension();
+  return extension == ".obj" || extension == ".stl";
+}
+
+// Buckets every streamed entity without touching its resources; Update then
+// loads the wanted chunks nearest first and drops the rest
+void LevelStreamer::Rebuild() {
+  m_ChunkSize = stream_chunk_size.GetFloat();
+  m_Chunks.clear();
+  m_EntityChunks.clear();
+  m_RebucketCursor = 0;
+  if (!m_Scene)
+    return;
+
+  EntityRegistry &registry = m_Scene->GetRegistry();
+  for (const Ref<Entity> &entity : m_Scene->GetEntities()) {
+    if (!IsStreamed(entity))
+      continue;
+    glm::mat4 world = registry.ComputeWorldTransform(entity->GetHandle());
+    Track(entity, GetChunkKey(glm::vec3(world[3])), false);
+  }
+  m_Resync = true;
+  S67_CORE_INFO("Streaming {0} entities in {1} chunks of {2}",
+                m_EntityChunks.size(), m_Chunks.size(), m_ChunkSize);
+}
+
+void LevelStreamer::Rebucket(size_t count) {
+  const auto &entities = m_Scene->GetEntities();
+  EntityRegistry &registry = m_Scene->GetRegistry();
+  count = std::min(count, entities.size());
+  for (size_t i = 0; i < count; i++) {
+    if (m_RebucketCursor >= entities.size())
+      m_RebucketCursor = 0;
+    const Ref<Entity> &entity = entities[m_RebucketCursor++];
+    EntityHandle handle = entity->GetHandle();
+    int64_t key =
+        GetChunkKey(glm::vec3(registry.ComputeWorldTransform(handle)[3]));
+
+    auto it = m_EntityChunks.find(handle.Value);
+    if (it == m_EntityChunks.end()) {
+      if (IsStreamed(entity))
+        Track(entity, key, true);
+      continue;
+    }
+    if (it->second == key)
+      continue;
+
+    auto &previous = m_Chunks[it->second].Entities;
+    auto stale = std::find(previous.begin(), previous.end(), handle);
+    if (stale != previous.end())
+      previous.erase(stale);
+    m_EntityChunks.erase(it);
+    Track(entity, key, true);
+  }
+}
+
+// With apply, the entity's resources are brought in line with the chunk it
+// lands in right away; a chunk created for it is loaded if it is wanted
+void LevelStreamer::Track(const Ref<Entity> &entity, int64_t key, bool apply) {
+  auto [it, created] = m_Chunks.try_emplace(key);
+  Chunk &chunk = it->second;
+  if (created && apply)
+    chunk.Loaded = IsWanted(key, stream_radius.GetFloat());
+  chunk.Entities.push_back(entity->GetHandle());
+  m_EntityChunks[entity->GetHandle().Value] = key;
+  Remember(entity);
+
+  if (!apply)
+    return;
+  if (chunk.Loaded)
+    Request(entity);
+  else
+    Evict(entity);
+}
+
+float LevelStreamer::ChunkDistanceSquared(int64_t key) const {
+  glm::vec2 min = glm::vec2(static_cast<int32_t>(key >> 32),
+                            static_cast<int32_t>(static_cast<uint32_t>(key))) *
+                  m_ChunkSize;
+  glm::vec2 max = min + glm::vec2(m_ChunkSize);
+
+  float nearest = std::numeric_limits<float>::max();
+  for (const glm::vec3 &point : m_FocusPoints) {
+    glm::vec2 p(point.x, point.z);
+    glm::vec2 d = glm::max(glm::max(min - p, p - max), glm::vec2(0.0f));
+    nearest = std::min(nearest, glm::dot(d, d));
+  }
+  return nearest;
+}
+
+bool LevelStreamer::IsWanted(int64_t key, float radius) const {
+  return !stream_enable.GetBool() ||
+         ChunkDistanceSquared(key) <= radius * radius;
+}
+
+bool LevelStreamer::IsLoaded(EntityHandle handle) const {
+  auto it = m_EntityChunks.find(handle.Value);
+  return it != m_EntityChunks.end() && m_Chunks.at(it->second).Loaded;
+}
+
+// Visits the chunk's live entities, pruning handles of destroyed ones
+template <typename Func>
+void LevelStreamer::ForEachEntity(Chunk &chunk, Func &&func) {
+  auto &handles = chunk.Entities;
+  for (size_t i = 0; i < handles.size();) {
+    Ref<Entity> entity = m_Scene->GetEntity(handles[i]);
+    if (!entity) {
+      m_EntityChunks.erase(handles[i].Value);
+      handles[i] = handles.back();
+      handles.pop_back();
+      continue;
+    }
+    func(entity);
+    i++;
+  }
+}
+
+void LevelStreamer::LoadChunk(Chunk &chunk) {
+  chunk.Loaded = true;
+  ForEachEntity(chunk, [this](const Ref<Entity> &entity) { Request(entity); });
+}
+
+void LevelStreamer::UnloadChunk(Chunk &chunk) {
+  chunk.Loaded = false;
+  ForEachEntity(chunk, [this](const Ref<Entity> &entity) { Evict(entity); });
+}
+
+bool LevelStreamer::IsStreamed(const Ref<Entity> &entity) const {
+  const Material &material = entity->Material;
+  return IsStreamedMesh(entity->MeshPath) || !material.AlbedoPath.empty() ||
+         (material.AlbedoMap &&
+          material.AlbedoMap != Application::Get().GetDefaultTexture());
+}
+
+const std::string &LevelStreamer::Resolve(const std::string &path) {
+  auto [it, inserted] = m_ResolvedPaths.try_emplace(path);
+  if (inserted)
+    it->second = Application::Get().ResolveAssetPath(path).string();
+  return it->second;
+}
+
+void LevelStreamer::Request(const Ref<Entity> &entity) {
+  if (!entity->Mesh && IsStreamedMesh(entity->MeshPath)) {
+    const std::string &path = Resolve(entity->MeshPath);
+    auto it = m_ResidentMeshes.find(path);
+    if (it != m_ResidentMeshes.end())
+      entity->Mesh = it->second.lock();
+    if (!entity->Mesh)
+      Enqueue(AssetType::Mesh, path, {entity->GetHandle(), entity->MeshPath});
+  }
+
+  Material &material = entity->Material;
+  if (!material.AlbedoMap && !material.AlbedoPath.empty()) {
+    material.AlbedoMap = TextureCache::Find(material.AlbedoPath);
+    if (material.AlbedoMap)
+      material.AlbedoPath.clear();
+    else
+      Enqueue(AssetType::Texture, material.AlbedoPath,
+              {entity->GetHandle(), material.AlbedoPath});
+  }
+}
+
+// Puts the mesh an entity holds into the cache, so entities streaming in
+// later share it instead of decoding it again, however it was loaded.
+// Textures are always shared through the TextureCache.
+void LevelStreamer::Remember(const Ref<Entity> &entity) {
+  if (entity->Mesh && IsStreamedMesh(entity->MeshPath))
+    m_ResidentMeshes[Resolve(entity->MeshPath)] = entity->Mesh;
+}
+
+void LevelStreamer::Evict(const Ref<Entity> &entity) {
+  Remember(entity);
+  if (entity->Mesh && IsStreamedMesh(entity->MeshPath))
+    entity->Mesh = nullptr;
+
+  Material &material = entity->Material;
+  if (material.AlbedoMap &&
+      material.AlbedoMap != Application::Get().GetDefaultTexture()) {
+    material.AlbedoPath = material.AlbedoMap->GetPath();
+    material.AlbedoMap = nullptr;
+  }
+}
+
+void LevelStreamer::Enqueue(AssetType type, const std::string &path,
+                            Waiter waiter) {
+  auto &waiting =
+      type == AssetType::Mesh ? m_WaitingMeshes : m_WaitingTextures;
+  auto [it, inserted] = waiting.try_emplace(path);
+  for (const Waiter &existing : it->second) {
+    if (existing.Handle == waiter.Handle)
+      return;
+  }
+  it->second.push_back(std::move(waiter));
+  if (!inserted)
+    return; // Already queued or decoding
+
+  if (m_Workers.empty())
+    StartWorkers();
+  {
+    std::lock_guard<std::mutex> lock(m_JobMutex);
+    m_Jobs.push_back({type, path, m_Generation});
+  }
+  m_JobCondition.notify_one();
+}
+
+void LevelStreamer::Update(std::initializer_list<glm::vec3> focusPoints) {
+  if (!m_Scene)
+    return;
+
+  m_FocusPoints.assign(focusPoints);
+  if (stream_chunk_size.GetFloat() != m_ChunkSize)
+    Rebuild();
+  Rebucket(REBUCKET_PER_FRAME);
+
+  float radius = stream_radius.GetFloat();
+  m_LoadOrder.clear();
+  for (auto &[key, chunk] : m_Chunks) {
+    if (!chunk.Loaded) {
+      if (IsWanted(key, radius))
+        m_LoadOrder.push_back({ChunkDistanceSquared(key), key});
+      else if (m_Resync)
+        UnloadChunk(chunk);
+    } else if (!IsWanted(key, radius * UNLOAD_HYSTERESIS)) {
+      UnloadChunk(chunk);
+    } else if (m_Resync) {
+      LoadChunk(chunk);
+    }
+  }
+  m_Resync = false;
+
+  // Nearest chunks queue their assets first
+  std::sort(m_LoadOrder.begin(), m_LoadOrder.end());
+  for (const auto &[distance, key] : m_LoadOrder)
+    LoadChunk(m_Chunks[key]);
+
+  DrainResults(stream_upload_ms.GetFloat());
+
+  m_Statistics.Chunks = static_cast<uint32_t>(m_Chunks.size());
+  m_Statistics.LoadedChunks = static_cast<uint32_t>(
+      std::count_if(m_Chunks.begin(), m_Chunks.end(),
+                    [](const auto &entry) { return entry.second.Loaded; }));
+  m_Statistics.TrackedEntities = static_cast<uint32_t>(m_EntityChunks.size());
+  m_Statistics.PendingAssets =
+      static_cast<uint32_t>(m_WaitingMeshes.size() + m_WaitingTextures.size());
+  auto countResident = [](auto &cache) {
+    std::erase_if(cache, [](const auto &entry) {
+      return entry.second.expired();
+    });
+    return static_cast<uint32_t>(cache.size());
+  };
+  m_Statistics.ResidentMeshes = countResident(m_ResidentMeshes);
+  m_Statistics.ResidentTextures = TextureCache::GetStatistics().Resident;
+}
+
+void LevelStreamer::DrainResults(float budgetMillis) {
+  Timer timer;
+  uint32_t uploads = 0;
+  while (uploads == 0 || timer.ElapsedMillis() < budgetMillis) {
+    Result result;
+    {
+      std::lock_guard<std::mutex> lock(m_ResultMutex);
+      if (m_Results.empty())
+        break;
+      result = std::move(m_Results.front());
+      m_Results.pop_front();
+    }
+    if (result.Generation == m_Generation && Complete(result))
+      uploads++;
+  }
+
+  m_Statistics.UploadsLastFrame = uploads;
+  m_Statistics.UploadMillisLastFrame = timer.ElapsedMillis();
+}
+
+// Uploads a decoded asset and hands it to the entities still waiting for it.
+// Returns false without uploading if none of them wants it any more.
+bool LevelStreamer::Complete(Result &result) {
+  bool isMesh = result.Type == AssetType::Mesh;
+  auto &waiting = isMesh ? m_WaitingMeshes : m_WaitingTextures;
+  auto it = waiting.find(result.Path);
+  if (it == waiting.end())
+    return false;
+  std::vector<Waiter> waiters = std::move(it->second);
+  waiting.erase(it);
+  if (!result.Success)
+    return false;
+
+  std::vector<Ref<Entity>> targets;
+  for (const Waiter &waiter : waiters) {
+    Ref<Entity> entity = m_Scene->GetEntity(waiter.Handle);
+    if (!entity || !IsLoaded(waiter.Handle))
+      continue;
+    bool stillWanted =
+        isMesh ? !entity->Mesh && entity->MeshPath == waiter.SourcePath
+               : !entity->Material.AlbedoMap &&
+                     entity->Material.AlbedoPath == waiter.SourcePath;
+    if (stillWanted)
+      targets.push_back(entity);
+  }
+  if (targets.empty())
+    return false;
+
+  if (isMesh) {
+    Ref<VertexArray> mesh = MeshLoader::Upload(result.Mesh);
+    m_ResidentMeshes[result.Path] = mesh;
+    for (const Ref<Entity> &entity : targets)
+      entity->Mesh = mesh;
+  } else {
+    Ref<Texture2D> texture = TextureCache::Add(result.Texture);
+    for (const Ref<Entity> &entity : targets) {
+      entity->Material.AlbedoMap = texture;
+      entity->Material.AlbedoPath.clear();
+    }
+  }
+  return true;
+}
+
+} // namespace S67
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Renderer/Scene.h"
+#include "Renderer/Texture.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace S67 {
+
+/**
+ * @brief Streams meshes and textures in and out around the cameras
+ *
+ * The level is cut into square chunks on the XZ plane (stream_chunk_size).
+ * Chunks within stream_radius of a focus point are loaded: the .obj/.stl
+ * meshes and textures their entities use are decoded on worker threads and
+ * uploaded to GL on the main thread, at most stream_upload_ms per frame.
+ * Chunks that fall well outside the radius drop their render resources
+ * again, keeping only the paths. Each asset is decoded once however many
+ * entities share it, and stays resident while any of them holds it.
+ *
+ * Entities are bucketed by world position when the streamer is reset and
+ * re-bucketed a slice per frame after that, so movers and entities created
+ * later end up in the right chunk. Entity records, shaders and physics bodies
+ * are not streamed. Everything runs on the main thread (with the simulation
+ * lock held) except the decoding.
+ */
+class LevelStreamer {
+public:
+  struct Statistics {
+    uint32_t Chunks = 0;
+    uint32_t LoadedChunks = 0;
+    uint32_t TrackedEntities = 0;
+    uint32_t PendingAssets = 0;   // Queued or decoding
+    uint32_t ResidentMeshes = 0;  // Still alive in the cache
+    uint32_t ResidentTextures = 0; // In the TextureCache
+    uint32_t UploadsLastFrame = 0;
+    float UploadMillisLastFrame = 0.0f;
+  };
+
+  LevelStreamer();
+  ~LevelStreamer();
+
+  LevelStreamer(const LevelStreamer &) = delete;
+  LevelStreamer &operator=(const LevelStreamer &) = delete;
+
+  // Starts over with a new scene (nullptr to stop streaming); every chunk
+  // starts unloaded. Results still in flight for the old scene are dropped.
+  void Reset(Scene *scene);
+  // Re-applies every chunk's state to its entities on the next Update, for
+  // when their components were overwritten wholesale (play-mode restore)
+  void Refresh() { m_Resync = true; }
+
+  // Main thread, once a frame, with the cameras the level is seen from
+  void Update(std::initializer_list<glm::vec3> focusPoints);
+
+  const Statistics &GetStatistics() const { return m_Statistics; }
+
+  // Whether levels are opened with their assets deferred to the streamer
+  static bool IsEnabled();
+  // Chunk a world position falls in at the current chunk size, for grouping
+  // other work spatially
+  int64_t GetChunkKey(const glm::vec3 &position) const;
+  static bool IsStreamedMesh(const std::string &meshPath);
+
+private:
+  enum class AssetType { Mesh, Texture };
+
+  struct Chunk {
+    std::vector<EntityHandle> Entities;
+    bool Loaded = false;
+  };
+  struct Job {
+    AssetType Type;
+    std::string Path;
+    uint32_t Generation;
+  };
+  struct Result {
+    AssetType Type;
+    std::string Path;
+    uint32_t Generation;
+    bool Success = false;
+    MeshData Mesh;
+    TextureData Texture;
+  };
+  // An entity waiting for an asset, with the path it asked for so a changed
+  // path is not overwritten by a stale result
+  struct Waiter {
+    EntityHandle Handle;
+    std::string SourcePath;
+  };
+
+  void StartWorkers();
+  void WorkerMain();
+
+  void Rebuild();
+  void Rebucket(size_t count);
+  void Track(const Ref<Entity> &entity, int64_t key, bool apply);
+  float ChunkDistanceSquared(int64_t key) const;
+  bool IsWanted(int64_t key, float radius) const;
+  bool IsLoaded(EntityHandle handle) const;
+  template <typename Func> void ForEachEntity(Chunk &chunk, Func &&func);
+  void LoadChunk(Chunk &chunk);
+  void UnloadChunk(Chunk &chunk);
+  bool IsStreamed(const Ref<Entity> &entity) const;
+  const std::string &Resolve(const std::string &path);
+  void Remember(const Ref<Entity> &entity);
+  void Request(const Ref<Entity> &entity);
+  void Evict(const Ref<Entity> &entity);
+  void Enqueue(AssetType type, const std::string &path, Waiter waiter);
+  void DrainResults(float budgetMillis);
+  bool Complete(Result &result);
+
+  Scene *m_Scene = nullptr;
+  uint32_t m_Generation = 0;
+  float m_ChunkSize = 0.0f;
+  bool m_Resync = false;
+  std::vector<glm::vec3> m_FocusPoints;
+  std::vector<std::pair<float, int64_t>> m_LoadOrder; // Scratch
+
+  std::unordered_map<int64_t, Chunk> m_Chunks;
+  std::unordered_map<uint32_t, int64_t> m_EntityChunks; // Handle value
+  size_t m_RebucketCursor = 0;
+
+  std::unordered_map<std::string, std::string> m_ResolvedPaths;
+  std::unordered_map<std::string, std::vector<Waiter>> m_WaitingMeshes;
+  std::unordered_map<std::string, std::vector<Waiter>> m_WaitingTextures;
+  std::unordered_map<std::string, std::weak_ptr<VertexArray>> m_ResidentMeshes;
+
+  std::vector<std::thread> m_Workers;
+  std::mutex m_JobMutex;
+  std::condition_variable m_JobCondition;
+  std::deque<Job> m_Jobs;
+  bool m_Stopping = false;
+  std::mutex m_ResultMutex;
+  std::deque<Result> m_Results;
+
+  Statistics m_Statistics;
+};
+
+} // namespace S67
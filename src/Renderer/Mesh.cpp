@@ -2,6 +2,8 @@
 #include "Mesh.h"
 #include "Core/Logger.h"
 #include "tinyobjloader/tiny_obj_loader.h"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
@@ -39,7 +41,69 @@ template <> struct hash<S67::OBJVertex> {
 
 namespace S67 {
 
+// OBJVertex is laid out exactly as MeshData's interleaved floats
+static_assert(sizeof(OBJVertex) == 8 * sizeof(float));
+
+static void StoreMeshData(const std::vector<OBJVertex> &vertices,
+                          std::vector<uint32_t> &indices, MeshData &data) {
+  const float *floats = reinterpret_cast<const float *>(vertices.data());
+  data.Vertices.assign(floats, floats + vertices.size() * 8);
+  data.Indices = std::move(indices);
+
+  // Box first, then the sphere around its center that reaches every vertex
+  if (vertices.empty()) {
+    data.Bounds = {glm::vec3(0.0f), glm::vec3(0.0f)};
+    data.Sphere = {glm::vec3(0.0f), 0.0f};
+    return;
+  }
+  data.Bounds = {vertices[0].Position, vertices[0].Position};
+  for (const OBJVertex &vertex : vertices) {
+    data.Bounds.Min = glm::min(data.Bounds.Min, vertex.Position);
+    data.Bounds.Max = glm::max(data.Bounds.Max, vertex.Position);
+  }
+  glm::vec3 center = data.Bounds.GetCenter();
+  float radiusSquared = 0.0f;
+  for (const OBJVertex &vertex : vertices) {
+    glm::vec3 offset = vertex.Position - center;
+    radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+  }
+  data.Sphere = {center, std::sqrt(radiusSquared)};
+}
+
 Ref<VertexArray> MeshLoader::LoadOBJ(const std::string &path) {
+  MeshData data;
+  if (!ParseOBJ(path, data))
+    return nullptr;
+  return Upload(data);
+}
+
+Ref<VertexArray> MeshLoader::LoadSTL(const std::string &path) {
+  MeshData data;
+  if (!ParseSTL(path, data))
+    return nullptr;
+  return Upload(data);
+}
+
+Ref<VertexArray> MeshLoader::Upload(const MeshData &data) {
+  Ref<VertexArray> va = VertexArray::Create();
+  Ref<VertexBuffer> vb = VertexBuffer::Create(
+      const_cast<float *>(data.Vertices.data()),
+      (uint32_t)(data.Vertices.size() * sizeof(float)));
+  vb->SetLayout({{ShaderDataType::Float3, "a_Position"},
+                 {ShaderDataType::Float3, "a_Normal"},
+                 {ShaderDataType::Float2, "a_TexCoord"}});
+  va->AddVertexBuffer(vb);
+
+  Ref<IndexBuffer> ib = IndexBuffer::Create(
+      const_cast<uint32_t *>(data.Indices.data()),
+      (uint32_t)data.Indices.size());
+  va->SetIndexBuffer(ib);
+  va->SetBounds(data.Bounds, data.Sphere);
+
+  return va;
+}
+
+bool MeshLoader::ParseOBJ(const std::string &path, MeshData &data) {
   tinyobj::attrib_t attrib;
   std::vector<tinyobj::shape_t> shapes;
   std::vector<tinyobj::material_t> materials;
@@ -48,7 +112,7 @@ Ref<VertexArray> MeshLoader::LoadOBJ(const std::string &path) {
   if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
                         path.c_str())) {
     S67_CORE_ERROR("Failed to load OBJ: {0}", err);
-    return nullptr;
+    return false;
   }
 
   std::vector<OBJVertex> vertices;
@@ -95,27 +159,15 @@ Ref<VertexArray> MeshLoader::LoadOBJ(const std::string &path) {
                 "Generated Auto-UVs for others)",
                 path, vertices.size(), indices.size(), uvCount);
 
-  Ref<VertexArray> va = VertexArray::Create();
-  Ref<VertexBuffer> vb =
-      VertexBuffer::Create((float *)vertices.data(),
-                           (uint32_t)(vertices.size() * sizeof(OBJVertex)));
-  vb->SetLayout({{ShaderDataType::Float3, "a_Position"},
-                 {ShaderDataType::Float3, "a_Normal"},
-                 {ShaderDataType::Float2, "a_TexCoord"}});
-  va->AddVertexBuffer(vb);
-
-  Ref<IndexBuffer> ib =
-      IndexBuffer::Create(indices.data(), (uint32_t)indices.size());
-  va->SetIndexBuffer(ib);
-
-  return va;
+  StoreMeshData(vertices, indices, data);
+  return true;
 }
 
-Ref<VertexArray> MeshLoader::LoadSTL(const std::string &path) {
+bool MeshLoader::ParseSTL(const std::string &path, MeshData &data) {
   std::ifstream file(path, std::ios::binary);
   if (!file.is_open()) {
     S67_CORE_ERROR("Failed to open STL file: {0}", path);
-    return nullptr;
+    return false;
   }
 
   // STL Binary header is 80 bytes, ignored.
@@ -123,12 +175,16 @@ Ref<VertexArray> MeshLoader::LoadSTL(const std::string &path) {
   size_t fileSize = file.tellg();
   if (fileSize < 84) {
     S67_CORE_ERROR("STL file too small: {0}", path);
-    return nullptr;
+    return false;
   }
   file.seekg(80, std::ios::beg);
 
   uint32_t triangleCount;
   file.read(reinterpret_cast<char *>(&triangleCount), sizeof(uint32_t));
+  if (fileSize < 84 + (size_t)triangleCount * 50) {
+    S67_CORE_ERROR("STL file truncated: {0}", path);
+    return false;
+  }
 
   std::vector<OBJVertex> vertices;
   std::vector<uint32_t> indices;
@@ -167,20 +223,8 @@ Ref<VertexArray> MeshLoader::LoadSTL(const std::string &path) {
   S67_CORE_INFO("Loaded STL: {0} ({1} triangles, Generated Auto-UVs)", path,
                 triangleCount);
 
-  Ref<VertexArray> va = VertexArray::Create();
-  Ref<VertexBuffer> vb =
-      VertexBuffer::Create((float *)vertices.data(),
-                           (uint32_t)(vertices.size() * sizeof(OBJVertex)));
-  vb->SetLayout({{ShaderDataType::Float3, "a_Position"},
-                 {ShaderDataType::Float3, "a_Normal"},
-                 {ShaderDataType::Float2, "a_TexCoord"}});
-  va->AddVertexBuffer(vb);
-
-  Ref<IndexBuffer> ib =
-      IndexBuffer::Create(indices.data(), (uint32_t)indices.size());
-  va->SetIndexBuffer(ib);
-
-  return va;
+  StoreMeshData(vertices, indices, data);
+  return true;
 }
 
 Ref<VertexArray> MeshLoader::CreateCube() {
@@ -231,18 +275,9 @@ Ref<VertexArray> MeshLoader::CreateCube() {
   };
   indices.assign(indicesData, indicesData + 36);
 
-  Ref<VertexArray> va = VertexArray::Create();
-  Ref<VertexBuffer> vb =
-      VertexBuffer::Create((float *)vertices.data(),
-                           (uint32_t)(vertices.size() * sizeof(OBJVertex)));
-  vb->SetLayout({{ShaderDataType::Float3, "a_Position"},
-                 {ShaderDataType::Float3, "a_Normal"},
-                 {ShaderDataType::Float2, "a_TexCoord"}});
-  va->AddVertexBuffer(vb);
-  Ref<IndexBuffer> ib =
-      IndexBuffer::Create(indices.data(), (uint32_t)indices.size());
-  va->SetIndexBuffer(ib);
-  return va;
+  MeshData data;
+  StoreMeshData(vertices, indices, data);
+  return Upload(data);
 }
 
 Ref<VertexArray> MeshLoader::CreateCapsule(float radius, float height) {
@@ -336,18 +371,9 @@ Ref<VertexArray> MeshLoader::CreateCapsule(float radius, float height) {
   // now. It provides the visual "Top" and "Bottom" and collision shape
   // reference.
 
-  Ref<VertexArray> va = VertexArray::Create();
-  Ref<VertexBuffer> vb =
-      VertexBuffer::Create((float *)vertices.data(),
-                           (uint32_t)(vertices.size() * sizeof(OBJVertex)));
-  vb->SetLayout({{ShaderDataType::Float3, "a_Position"},
-                 {ShaderDataType::Float3, "a_Normal"},
-                 {ShaderDataType::Float2, "a_TexCoord"}});
-  va->AddVertexBuffer(vb);
-  Ref<IndexBuffer> ib =
-      IndexBuffer::Create(indices.data(), (uint32_t)indices.size());
-  va->SetIndexBuffer(ib);
-  return va;
+  MeshData data;
+  StoreMeshData(vertices, indices, data);
+  return Upload(data);
 }
 
 } // namespace S67
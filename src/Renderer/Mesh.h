@@ -1,14 +1,31 @@
 #pragma once
 
+#include "Bounds.h"
 #include "VertexArray.h"
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace S67 {
 
+// Mesh as parsed from disk, before any GL objects exist
+struct MeshData {
+  std::vector<float> Vertices; // Position (3), Normal (3), TexCoord (2)
+  std::vector<uint32_t> Indices;
+  // Of the positions; Upload() hands them to the vertex array
+  AABB Bounds;
+  BoundingSphere Sphere;
+};
+
 class MeshLoader {
 public:
   static Ref<VertexArray> LoadOBJ(const std::string &path);
   static Ref<VertexArray> LoadSTL(const std::string &path);
+  // Parsing touches no GL state, so it can run on a worker thread; the
+  // result is uploaded on the main thread with Upload()
+  static bool ParseOBJ(const std::string &path, MeshData &data);
+  static bool ParseSTL(const std::string &path, MeshData &data);
+  static Ref<VertexArray> Upload(const MeshData &data);
   static Ref<VertexArray> CreateCapsule(float radius, float height);
   static Ref<VertexArray> CreateCube();
 };
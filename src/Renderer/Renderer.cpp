@@ -1,48 +1,207 @@
 #include "Renderer.h"
+#include <algorithm>
+#include <cstring>
 #include <glad/glad.h>
 
 namespace S67 {
 
 Renderer::SceneData *Renderer::s_SceneData = new Renderer::SceneData();
+Renderer::Statistics Renderer::s_Statistics;
 
 void Renderer::Init() {
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
   glEnable(GL_DEPTH_TEST);
+
+  s_SceneData->FrameBuffer =
+      UniformBuffer::Create(sizeof(FrameUniforms),
+                            (uint32_t)UniformBlockBinding::Frame);
+
+  static_assert(sizeof(InstanceData) == 72, "tightly packed instances");
+  s_SceneData->InstanceBuffer =
+      VertexBuffer::Create(1024 * (uint32_t)sizeof(InstanceData));
+  s_SceneData->InstanceBuffer->SetLayout(
+      {{ShaderDataType::Mat4, "a_Transform"},
+       {ShaderDataType::Float2, "a_Tiling"}});
 }
 
 void Renderer::OnWindowResize(uint32_t width, uint32_t height) {
   glViewport(0, 0, width, height);
 }
 
+void Renderer::BeginFrame(float time) {
+  s_SceneData->DeltaTime = time - s_SceneData->Time;
+  s_SceneData->Time = time;
+  s_Statistics = Statistics();
+}
+
 void Renderer::BeginScene(const Camera &camera,
-                          const DirectionalLight &dirLight) {
-  s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
-  s_SceneData->DirLight = dirLight;
+                          const DirectionalLight &dirLight,
+                          const glm::vec2 &viewportSize) {
+  s_SceneData->CameraPosition =
+      glm::vec3(glm::inverse(camera.GetViewMatrix())[3]);
+  s_SceneData->Commands.clear();
+  s_SceneData->Keys.clear();
+
+  FrameUniforms frame;
+  frame.ViewProjection = camera.GetViewProjectionMatrix();
+  frame.View = camera.GetViewMatrix();
+  frame.Projection = camera.GetProjectionMatrix();
+  frame.CameraPosition = glm::vec4(s_SceneData->CameraPosition, 1.0f);
+  frame.SunDirection = glm::vec4(dirLight.Direction, dirLight.Intensity);
+  frame.SunColor = glm::vec4(dirLight.Color, 1.0f);
+  glm::vec2 size = glm::max(viewportSize, glm::vec2(1.0f));
+  frame.Viewport = glm::vec4(size, 1.0f / size);
+  frame.Time = glm::vec4(s_SceneData->Time, s_SceneData->DeltaTime, 0.0f, 0.0f);
+  if (s_SceneData->FrameBuffer)
+    s_SceneData->FrameBuffer->SetData(&frame, sizeof(frame));
 }
 
-void Renderer::EndScene() {}
+void Renderer::EndScene() { Flush(); }
 
 void Renderer::Submit(const Ref<Shader> &shader,
                       const Ref<VertexArray> &vertexArray,
                       const glm::mat4 &transform, const glm::vec2 &tiling) {
+  Material material;
+  material.Tiling = tiling;
+  Submit(shader, vertexArray, material, transform);
+}
+
+void Renderer::Submit(const Ref<Shader> &shader,
+                      const Ref<VertexArray> &vertexArray,
+                      const Material &material, const glm::mat4 &transform,
+                      RenderPass pass) {
   if (!shader || !shader->IsValid() || !vertexArray)
     return;
 
-  shader->Bind();
-  shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
-  shader->SetMat4("u_Transform", transform);
-  shader->SetInt("u_Texture", 0);
-  shader->SetFloat2("u_Tiling", tiling);
+  DrawCommand command;
+  command.MaterialShader = shader;
+  command.Mesh = vertexArray;
+  command.Texture = material.AlbedoMap;
+  command.Transform = transform;
+  command.Tiling = material.Tiling;
+
+  uint64_t key = MakeSortKey(command, pass);
+  s_SceneData->Keys.push_back(
+      {key, static_cast<uint32_t>(s_SceneData->Commands.size())});
+  s_SceneData->Commands.push_back(std::move(command));
+}
+
+// 2 bits pass | 14 bits shader | 16 bits texture | 16 bits mesh | 16 bits
+// depth, so opaque draws group by state and then go front to back. The
+// transparent pass puts (inverted) depth first to draw back to front. GL
+// names are small integers; truncating them only weakens the grouping.
+uint64_t Renderer::MakeSortKey(const DrawCommand &command, RenderPass pass) {
+  uint64_t shader = command.MaterialShader->GetRendererID() & 0x3FFF;
+  uint64_t texture =
+      command.Texture ? command.Texture->GetRendererID() & 0xFFFF : 0;
+  uint64_t mesh = command.Mesh->GetRendererID() & 0xFFFF;
+
+  // The top bits of a positive float order the same way as the float
+  glm::vec3 offset =
+      glm::vec3(command.Transform[3]) - s_SceneData->CameraPosition;
+  float distanceSquared = glm::dot(offset, offset);
+  uint32_t bits;
+  std::memcpy(&bits, &distanceSquared, sizeof(bits));
+  uint64_t depth = bits >> 16;
+
+  uint64_t key = (uint64_t)pass << 62;
+  if (pass == RenderPass::Transparent)
+    return key | (0xFFFF - depth) << 46 | shader << 32 | texture << 16 | mesh;
+  return key | shader << 48 | texture << 32 | mesh << 16 | depth;
+}
+
+void Renderer::Flush() {
+  auto &commands = s_SceneData->Commands;
+  auto &keys = s_SceneData->Keys;
+  if (keys.empty())
+    return;
+
+  // Ties keep submission order
+  std::sort(keys.begin(), keys.end());
+
+  // Every instance of the flush goes up in one upload, in draw order
+  auto &instances = s_SceneData->Instances;
+  instances.clear();
+  for (const auto &entry : keys) {
+    const DrawCommand &command = commands[entry.second];
+    instances.push_back({command.Transform, command.Tiling});
+  }
+  s_SceneData->InstanceBuffer->SetData(
+      instances.data(), (uint32_t)(instances.size() * sizeof(InstanceData)));
+
+  // Whatever ran between flushes may have changed the bindings
+  const Shader *boundShader = nullptr;
+  const Texture2D *boundTexture = nullptr;
+  const VertexArray *boundMesh = nullptr;
+  glm::vec2 tiling(-1.0f);
+  UniformHandle<glm::mat4> transformUniform;
+  UniformHandle<glm::vec2> tilingUniform;
+
+  for (size_t first = 0, last = 0; first < keys.size(); first = last) {
+    const DrawCommand &command = commands[keys[first].second];
+
+    // The run of draws sharing this one's shader, mesh and texture
+    for (last = first + 1; last < keys.size(); last++) {
+      const DrawCommand &next = commands[keys[last].second];
+      if (next.MaterialShader != command.MaterialShader ||
+          next.Mesh != command.Mesh || next.Texture != command.Texture)
+        break;
+    }
+
+    if (command.MaterialShader.get() != boundShader) {
+      Shader &shader = *command.MaterialShader;
+      shader.Bind();
+      boundShader = &shader;
+      s_Statistics.ShaderBinds++;
+
+      // Only shaders without instance attributes have these; tiling is
+      // whatever the program had last, so it is set again
+      transformUniform = shader.GetUniform<glm::mat4>("u_Transform");
+      tilingUniform = shader.GetUniform<glm::vec2>("u_Tiling");
+      tiling = glm::vec2(-1.0f);
+    }
+
+    if (command.Texture && command.Texture.get() != boundTexture) {
+      command.Texture->Bind();
+      boundTexture = command.Texture.get();
+      s_Statistics.TextureBinds++;
+    }
+
+    if (command.Mesh.get() != boundMesh) {
+      command.Mesh->Bind();
+      boundMesh = command.Mesh.get();
+      s_Statistics.VertexArrayBinds++;
+    }
+
+    GLsizei indexCount = command.Mesh->GetIndexBuffer()->GetCount();
+    s_Statistics.Instances += (uint32_t)(last - first);
+
+    if (!transformUniform.IsValid()) {
+      command.Mesh->SetInstanceBuffer(s_SceneData->InstanceBuffer,
+                                      INSTANCE_ATTRIBUTE_LOCATION,
+                                      (uint32_t)first);
+      glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT,
+                              nullptr, (GLsizei)(last - first));
+      s_Statistics.DrawCalls++;
+      continue;
+    }
 
-  // Lighting uniforms
-  shader->SetFloat3("u_DirLight.Direction", s_SceneData->DirLight.Direction);
-  shader->SetFloat3("u_DirLight.Color", s_SceneData->DirLight.Color);
-  shader->SetFloat("u_DirLight.Intensity", s_SceneData->DirLight.Intensity);
+    Shader &shader = *command.MaterialShader;
+    for (size_t i = first; i < last; i++) {
+      const DrawCommand &draw = commands[keys[i].second];
+      shader.Set(transformUniform, draw.Transform);
+      if (draw.Tiling != tiling) {
+        shader.Set(tilingUniform, draw.Tiling);
+        tiling = draw.Tiling;
+      }
+      glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+      s_Statistics.DrawCalls++;
+    }
+  }
 
-  vertexArray->Bind();
-  glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(),
-                 GL_UNSIGNED_INT, nullptr);
+  commands.clear();
+  keys.clear();
 }
 
 } // namespace S67
@@ -1,28 +1,107 @@
+#pragma once
+
+#include "Renderer/Buffer.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/Camera.h"
 #include "Renderer/Shader.h"
 #include "Renderer/Scene.h"
 #include "Renderer/Light.h"
+#include <cstdint>
+#include <vector>
 
 namespace S67 {
 
+    /**
+     * @brief Queued scene renderer
+     *
+     * Submit() only records a draw command with a 64-bit sort key; the queue
+     * is sorted and drawn by Flush() (and EndScene()), binding each shader,
+     * texture and vertex array only when it differs from the previous draw.
+     * Consecutive draws sharing shader, mesh and texture go out as one
+     * instanced draw, their transforms and tiling read from a per-instance
+     * vertex buffer (a_Transform at location 3, a_Tiling at 7). Shaders that
+     * still declare a u_Transform uniform are drawn one at a time instead.
+     *
+     * Camera, sun, viewport and time live in the std140 "Frame" uniform
+     * block, written once per BeginScene() and read by every shader that
+     * declares it, so draws only set their own transform and tiling.
+     *
+     * GL state the caller sets around a group of draws (stencil, polygon
+     * mode) must be followed by a Flush() before it is changed again.
+     */
     class Renderer {
     public:
+        enum class RenderPass : uint8_t { Opaque = 0, Transparent = 1 };
+
+        struct Statistics {
+            uint32_t DrawCalls = 0;
+            uint32_t Instances = 0; // Objects drawn
+            uint32_t ShaderBinds = 0;
+            uint32_t TextureBinds = 0;
+            uint32_t VertexArrayBinds = 0;
+        };
+
         static void Init();
         static void OnWindowResize(uint32_t width, uint32_t height);
 
-        static void BeginScene(const Camera& camera, const DirectionalLight& dirLight);
+        // Once a frame, before any scene; resets the statistics
+        static void BeginFrame(float time);
+        static void BeginScene(const Camera& camera, const DirectionalLight& dirLight, const glm::vec2& viewportSize);
         static void EndScene();
+        // Draws everything submitted so far
+        static void Flush();
 
         static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f), const glm::vec2& tiling = glm::vec2(1.0f));
+        static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const Material& material, const glm::mat4& transform, RenderPass pass = RenderPass::Opaque);
+
+        // Counts since the last BeginFrame()
+        static const Statistics& GetStatistics() { return s_Statistics; }
 
     private:
+        struct DrawCommand {
+            Ref<Shader> MaterialShader;
+            Ref<VertexArray> Mesh;
+            Ref<Texture2D> Texture; // Left as bound if null
+            glm::mat4 Transform;
+            glm::vec2 Tiling;
+        };
+
+        // One element of the per-instance vertex buffer
+        struct InstanceData {
+            glm::mat4 Transform;
+            glm::vec2 Tiling;
+        };
+        static constexpr uint32_t INSTANCE_ATTRIBUTE_LOCATION = 3;
+
+        // Mirrors the std140 "Frame" block declared by the shaders
+        struct FrameUniforms {
+            glm::mat4 ViewProjection;
+            glm::mat4 View;
+            glm::mat4 Projection;
+            glm::vec4 CameraPosition; // xyz
+            glm::vec4 SunDirection;   // xyz, w = intensity
+            glm::vec4 SunColor;       // rgb
+            glm::vec4 Viewport;       // xy = size in pixels, zw = 1 / size
+            glm::vec4 Time;           // x = seconds, y = frame delta
+        };
+        static_assert(sizeof(FrameUniforms) == 3 * 64 + 5 * 16, "std140 layout");
+
         struct SceneData {
-            glm::mat4 ViewProjectionMatrix;
-            DirectionalLight DirLight;
+            glm::vec3 CameraPosition;
+            float Time = 0.0f;
+            float DeltaTime = 0.0f;
+            Ref<UniformBuffer> FrameBuffer; // Created by Init()
+            Ref<VertexBuffer> InstanceBuffer;
+            std::vector<InstanceData> Instances; // Scratch, in draw order
+
+            std::vector<DrawCommand> Commands;
+            std::vector<std::pair<uint64_t, uint32_t>> Keys; // Key, command
         };
 
+        static uint64_t MakeSortKey(const DrawCommand& command, RenderPass pass);
+
         static SceneData* s_SceneData;
+        static Statistics s_Statistics;
     };
 
 }
@@ -4,46 +4,94 @@
 #include "Renderer/Entity.h"
 #include "Renderer/ScriptRegistry.h"
 #include "Mesh.h"
+#include "Physics/PhysicsSystem.h"
 #include "Physics/PlayerController.h"
 #include "Renderer/ScriptableEntity.h"
-#include "Texture.h"
+#include "TextureCache.h"
 #include "Scripting/LuaScriptEngine.h"
 #include <algorithm>
 
 namespace S67 {
 
-void Scene::EnsurePlayerExists() {
-  auto it =
-      std::find_if(m_Entities.begin(), m_Entities.end(),
-                   [](const Ref<Entity> &e) { return e->Name == "Player"; });
+Ref<Entity> Scene::CreateEntity(const std::string &name) {
+  // Façade and shared_ptr control block share one pool block
+  Ref<Entity> entity = std::allocate_shared<Entity>(
+      PoolAllocator<Entity>(m_EntityPool), m_Registry, m_Registry->Create());
+  entity->Name = name;
+  return entity;
+}
 
-  Ref<Entity> player;
+void Scene::RemoveEntity(const Ref<Entity> &entity) {
+  if (!entity)
+    return;
+
+  Ref<Entity> parent = GetParent(entity);
+  // Copy: reparenting edits the list
+  std::vector<EntityHandle> children = GetChildren(entity);
+  for (EntityHandle child : children)
+    SetParent(m_Registry->Find(child), parent);
+
+  // Otherwise the body stays in the world, pointing at a dead handle
+  if (!entity->PhysicsBody.IsInvalid()) {
+    auto &bodyInterface = PhysicsSystem::GetBodyInterface();
+    bodyInterface.RemoveBody(entity->PhysicsBody);
+    bodyInterface.DestroyBody(entity->PhysicsBody);
+    entity->PhysicsBody = JPH::BodyID();
+  }
+
+  m_Registry->Remove(entity->GetHandle());
+}
+
+bool Scene::SetParent(const Ref<Entity> &child, const Ref<Entity> &parent) {
+  if (!child)
+    return false;
+
+  EntityHandle childHandle = child->GetHandle();
+  EntityHandle parentHandle = parent ? parent->GetHandle() : EntityHandle();
+  if (m_Registry->GetParent(childHandle) == parentHandle)
+    return true;
+
+  // Work out the new local Transform before the link changes
+  glm::mat4 world = m_Registry->ComputeWorldTransform(childHandle);
+  glm::mat4 parentWorld = parent
+                              ? m_Registry->ComputeWorldTransform(parentHandle)
+                              : glm::mat4(1.0f);
+  if (!m_Registry->SetParent(childHandle, parentHandle))
+    return false;
+
+  child->Transform = Transform::FromMatrix(glm::inverse(parentWorld) * world);
+  return true;
+}
+
+void Scene::EnsurePlayerExists() {
+  Ref<Entity> player = FindEntityByName("Player");
 
-  if (it != m_Entities.end()) {
-    player = *it;
+  if (player) {
     // Move to front if not already
-    if (it != m_Entities.begin()) {
-      m_Entities.erase(it);
-      m_Entities.insert(m_Entities.begin(), player);
+    if (GetEntities().front() != player) {
+      m_Registry->Remove(player->GetHandle());
+      m_Registry->Insert(0, player);
     }
   } else {
     // Create new
-    player = CreateRef<Entity>();
-    player->Name = "Player";
+    player = CreateEntity("Player");
     player->Transform.Position = {0.0f, 2.0f, 0.0f};
     player->Transform.Scale = {1.0f, 1.5f, 1.0f}; // Enforce scale
-    m_Entities.insert(m_Entities.begin(), player);
+    m_Registry->Insert(0, player);
   }
 
-  // Enforce Visuals
-  if (!player->Mesh || player->MeshPath != "Cube") {
+  // Enforce Visuals (no GL context to create them on when headless)
+  bool headless = Application::Get().IsHeadless();
+  if (headless) {
+    player->MeshPath = "Cube";
+  } else if (!player->Mesh || player->MeshPath != "Cube") {
     player->Mesh = MeshLoader::CreateCube();
     player->MeshPath = "Cube";
   }
 
   // Enforce Texture (level_icon.png) only if missing
-  if (!player->Material.AlbedoMap) {
-    auto texture = Texture2D::Create("assets/textures/level_icon.png");
+  if (!headless && !player->Material.AlbedoMap) {
+    auto texture = TextureCache::Load("assets/textures/level_icon.png");
     if (texture) {
       player->Material.AlbedoMap = texture;
     } else {
@@ -55,7 +103,7 @@ void Scene::EnsurePlayerExists() {
   // Ensure Shader logic:
   // Entity constructor might not set Shader if created empty.
   // We need a shader.
-  if (!player->MaterialShader) {
+  if (!headless && !player->MaterialShader) {
     // Fallback to a known shader path if possible, or standard.
     // Application uses FlatColor.glsl usually. We can try to load it.
     // But paths are relative to executable or project root.
@@ -93,21 +141,16 @@ void Scene::EnsurePlayerExists() {
   }
 }
 
-Ref<Entity> Scene::FindEntityByName(const std::string &name) {
-  auto it = std::find_if(m_Entities.begin(), m_Entities.end(),
-                         [&](const Ref<Entity> &e) { return e->Name == name; });
-  if (it != m_Entities.end())
-    return *it;
-  return nullptr;
-}
-
 void Scene::InstantiateScripts() {
-  for (auto &entity : m_Entities) {
+  for (auto &entity : GetEntities()) {
     for (auto &script : entity->Scripts) {
       if (!script.Instance) {
         S67_CORE_INFO("Instantiating script {0} for entity {1}", script.Name,
                       entity->Name);
-        script.Instance = ScriptRegistry::Get().Instantiate(script.Name);
+        script.Instance =
+            script.InstantiateScript
+                ? script.InstantiateScript(m_ScriptArena)
+                : ScriptRegistry::Get().Instantiate(script.Name, m_ScriptArena);
         if (script.Instance) {
           script.Instance->m_Entity = entity.get();
           script.Instance->OnCreate();
@@ -126,20 +169,39 @@ void Scene::InstantiateScripts() {
   }
 }
 
+void Scene::Clear() {
+  DestroyScriptInstances();
+  m_Registry->Clear();
+}
+
+void Scene::DestroyScriptInstances() {
+  // Façades outside the scene (undo history, play backup) may still carry
+  // instance pointers, so clear every slot, not just members
+  m_Registry->ForEachSlot<ScriptComponent>([](ScriptComponent &scripts) {
+    for (auto &script : scripts.Scripts)
+      script.Instance = nullptr;
+  });
+  m_ScriptArena.Reset();
+}
+
 void Scene::OnUpdate(float ts) {
   LuaScriptEngine::BeginFrame();
   InstantiateScripts();
 
-  for (auto &entity : m_Entities) {
-    for (auto &script : entity->Scripts) {
+  // Walk the packed script pool; only entities with Lua need the façade
+  const auto &entities = GetEntities();
+  const auto &handles = m_Registry->GetHandles();
+  for (size_t i = 0; i < handles.size(); i++) {
+    ScriptComponent &scripts = m_Registry->Get<ScriptComponent>(handles[i]);
+    for (auto &script : scripts.Scripts) {
       if (script.Instance) {
         script.Instance->OnUpdate(ts);
       }
     }
 
-    for (auto &luaScript : entity->LuaScripts) {
+    for (auto &luaScript : scripts.LuaScripts) {
       if (luaScript.Initialized) {
-        LuaScriptEngine::OnUpdate(entity.get(), ts);
+        LuaScriptEngine::OnUpdate(entities[i].get(), ts);
       }
     }
   }
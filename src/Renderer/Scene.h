@@ -2,8 +2,10 @@
 
 #include "Camera.h"
 #include "Core/Base.h"
+#include "Core/BlockPool.h"
+#include "Core/ObjectArena.h"
 #include "Entity.h"
-#include <algorithm>
+#include "EntityRegistry.h"
 #include <vector>
 
 namespace S67 {
@@ -11,22 +13,68 @@ namespace S67 {
 class Scene {
 public:
   Scene() = default;
+  ~Scene() { Clear(); }
 
-  void AddEntity(const Ref<Entity> &entity) { m_Entities.push_back(entity); }
-  void RemoveEntity(const Ref<Entity> &entity) {
-    auto it = std::find(m_Entities.begin(), m_Entities.end(), entity);
-    if (it != m_Entities.end())
-      m_Entities.erase(it);
-  }
+  // Allocates the entity's components; it joins the scene on AddEntity
+  Ref<Entity> CreateEntity(const std::string &name = "Entity");
+
+  void AddEntity(const Ref<Entity> &entity) { m_Registry->Add(entity); }
+  // Children of a removed entity move up to its parent, staying in place;
+  // its physics body is destroyed
+  void RemoveEntity(const Ref<Entity> &entity);
   void EnsurePlayerExists();
   void OnUpdate(float ts);
   void InstantiateScripts();
-  Ref<Entity> FindEntityByName(const std::string &name);
-  void Clear() { m_Entities.clear(); }
-  const std::vector<Ref<Entity>> &GetEntities() const { return m_Entities; }
+  // O(1) lookups through the registry's name and tag indexes
+  Ref<Entity> FindEntityByName(const std::string &name) const {
+    return m_Registry->FindByName(name);
+  }
+  const std::vector<EntityHandle> &
+  FindEntitiesByTag(const std::string &tag) const {
+    return m_Registry->GetTagged(tag);
+  }
+
+  // Keep the indexes in step when editing a member's name or tags
+  void RenameEntity(const Ref<Entity> &entity, const std::string &name) {
+    m_Registry->Rename(entity->GetHandle(), name);
+  }
+  bool AddTag(const Ref<Entity> &entity, const std::string &tag) {
+    return m_Registry->AddTag(entity->GetHandle(), tag);
+  }
+  void RemoveTag(const Ref<Entity> &entity, const std::string &tag) {
+    m_Registry->RemoveTag(entity->GetHandle(), tag);
+  }
+  // Parents child under parent (nullptr to unparent) without moving it in
+  // the world. Returns false if parent is child or one of its descendants.
+  bool SetParent(const Ref<Entity> &child, const Ref<Entity> &parent);
+  Ref<Entity> GetParent(const Ref<Entity> &entity) const {
+    return m_Registry->Find(m_Registry->GetParent(entity->GetHandle()));
+  }
+  const std::vector<EntityHandle> &
+  GetChildren(const Ref<Entity> &entity) const {
+    return m_Registry->GetChildren(entity->GetHandle());
+  }
+  Ref<Entity> GetEntity(EntityHandle handle) const {
+    return m_Registry->Find(handle);
+  }
+  // Also destroys every native script instance
+  void Clear();
+  // Destroys the native script instances without touching the entities; they
+  // are recreated by the next InstantiateScripts()
+  void DestroyScriptInstances();
+  const std::vector<Ref<Entity>> &GetEntities() const {
+    return m_Registry->GetEntities();
+  }
+
+  EntityRegistry &GetRegistry() { return *m_Registry; }
+  const EntityRegistry &GetRegistry() const { return *m_Registry; }
 
 private:
-  std::vector<Ref<Entity>> m_Entities;
+  Ref<EntityRegistry> m_Registry = CreateRef<EntityRegistry>();
+  // Shared with every allocator copy, so façades kept past the scene (undo
+  // history) can still be freed into it
+  Ref<BlockPool> m_EntityPool = CreateRef<BlockPool>();
+  ObjectArena m_ScriptArena;
 };
 
 } // namespace S67
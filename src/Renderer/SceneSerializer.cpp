@@ -3,6 +3,7 @@
 #include "Core/Logger.h"
 #include "Renderer/Mesh.h"
 #include "Renderer/ScriptRegistry.h"
+#include "Renderer/TextureCache.h"
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
@@ -10,11 +11,89 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 using json = nlohmann::ordered_json;
 
 namespace S67 {
 
+// Prefab records by resolved path, reread when the file changes on disk
+struct PrefabAsset {
+  json Record;
+  std::filesystem::file_time_type WriteTime;
+};
+static std::unordered_map<std::string, PrefabAsset> s_Prefabs;
+
+// Numbers are compared against what SerializeEntity() writes, which went
+// through float; "0.1" read from disk would never match 0.1f otherwise
+static void RoundToFloat(json &value) {
+  if (value.is_number_float()) {
+    value = (double)(float)value.get<double>();
+  } else if (value.is_structured()) {
+    for (auto &element : value)
+      RoundToFloat(element);
+  }
+}
+
+static const json *LoadPrefab(const std::string &resolvedPath) {
+  std::error_code error;
+  auto writeTime = std::filesystem::last_write_time(resolvedPath, error);
+  if (error) {
+    S67_CORE_ERROR("Prefab '{0}' not found", resolvedPath);
+    s_Prefabs.erase(resolvedPath);
+    return nullptr;
+  }
+
+  auto it = s_Prefabs.find(resolvedPath);
+  if (it != s_Prefabs.end() && it->second.WriteTime == writeTime)
+    return &it->second.Record;
+
+  try {
+    std::ifstream fin(resolvedPath);
+    json data = json::parse(fin);
+    if (!data.contains("Prefab") || !data["Prefab"].is_object()) {
+      S67_CORE_ERROR("'{0}' is not a prefab", resolvedPath);
+      s_Prefabs.erase(resolvedPath);
+      return nullptr;
+    }
+
+    PrefabAsset &asset = s_Prefabs[resolvedPath];
+    asset.Record = std::move(data["Prefab"]);
+    asset.WriteTime = writeTime;
+    RoundToFloat(asset.Record);
+    return &asset.Record;
+  } catch (const std::exception &e) {
+    S67_CORE_ERROR("JSON parsing failed for prefab '{0}': {1}", resolvedPath,
+                   e.what());
+    s_Prefabs.erase(resolvedPath);
+    return nullptr;
+  }
+}
+
+// JSON merge patch (RFC 7396) turning base into value: changed fields, with
+// nested objects diffed recursively, and null for fields value doesn't have
+static json Diff(const json &base, const json &value) {
+  json patch = json::object();
+  for (auto it = value.begin(); it != value.end(); ++it) {
+    auto baseIt = base.find(it.key());
+    if (baseIt == base.end()) {
+      patch[it.key()] = it.value();
+    } else if (baseIt->is_object() && it->is_object()) {
+      json nested = Diff(*baseIt, *it);
+      if (!nested.empty())
+        patch[it.key()] = std::move(nested);
+    } else if (*baseIt != *it) {
+      patch[it.key()] = it.value();
+    }
+  }
+  for (auto it = base.begin(); it != base.end(); ++it) {
+    if (!value.contains(it.key()))
+      patch[it.key()] = nullptr;
+  }
+  return patch;
+}
+
 SceneSerializer::SceneSerializer(Scene *scene, const std::string &projectRoot)
     : m_Scene(scene), m_ProjectRoot(projectRoot) {}
 
@@ -51,6 +130,83 @@ std::string SceneSerializer::MakeRelative(const std::string &path) {
   return p.generic_string();
 }
 
+json SceneSerializer::SerializeEntity(const Ref<Entity> &entity) {
+  json e;
+  e["Entity"] = entity->Name;
+
+  json transform;
+  transform["Position"] = {entity->Transform.Position.x,
+                           entity->Transform.Position.y,
+                           entity->Transform.Position.z};
+  transform["Rotation"] = {entity->Transform.Rotation.x,
+                           entity->Transform.Rotation.y,
+                           entity->Transform.Rotation.z};
+  transform["Scale"] = {entity->Transform.Scale.x, entity->Transform.Scale.y,
+                        entity->Transform.Scale.z};
+  e["Transform"] = transform;
+
+  e["MeshPath"] = MakeRelative(entity->MeshPath);
+  e["ShaderPath"] = entity->MaterialShader
+                        ? MakeRelative(entity->MaterialShader->GetPath())
+                        : "None";
+  const std::string &texturePath = entity->Material.AlbedoMap
+                                       ? entity->Material.AlbedoMap->GetPath()
+                                       : entity->Material.AlbedoPath;
+  e["TexturePath"] = texturePath.empty() ? "None" : MakeRelative(texturePath);
+
+  if (!texturePath.empty()) {
+    e["TextureTiling"] = {entity->Material.Tiling.x,
+                          entity->Material.Tiling.y};
+  }
+
+  e["Collidable"] = entity->Collidable;
+  e["Anchored"] = entity->Anchored;
+
+  // Tags
+  if (!entity->Tags.empty()) {
+    e["Tags"] =
+        std::vector<std::string>(entity->Tags.begin(), entity->Tags.end());
+  }
+
+  // Native Scripts
+  if (!entity->Scripts.empty()) {
+    json scripts = json::array();
+    for (const auto &script : entity->Scripts) {
+      json s;
+      s["Name"] = script.Name;
+      scripts.push_back(s);
+    }
+    e["Scripts"] = scripts;
+  }
+
+  // Lua Scripts
+  if (!entity->LuaScripts.empty()) {
+    json luaScripts = json::array();
+    for (auto &script : entity->LuaScripts) {
+      luaScripts.push_back(MakeRelative(script.FilePath));
+    }
+    e["LuaScripts"] = luaScripts;
+  }
+
+  if (entity->Name == "Player") {
+    e["CameraFOV"] = entity->CameraFOV;
+    json movement;
+    movement["MaxSpeed"] = entity->Movement.MaxSpeed;
+    movement["MaxSprintSpeed"] = entity->Movement.MaxSprintSpeed;
+    movement["MaxCrouchSpeed"] = entity->Movement.MaxCrouchSpeed;
+    movement["Acceleration"] = entity->Movement.Acceleration;
+    movement["AirAcceleration"] = entity->Movement.AirAcceleration;
+    movement["Friction"] = entity->Movement.Friction;
+    movement["StopSpeed"] = entity->Movement.StopSpeed;
+    movement["JumpVelocity"] = entity->Movement.JumpVelocity;
+    movement["Gravity"] = entity->Movement.Gravity;
+    movement["MaxAirWishSpeed"] = entity->Movement.MaxAirWishSpeed;
+    e["Movement"] = movement;
+  }
+
+  return e;
+}
+
 void SceneSerializer::Serialize(const std::string &filepath) {
   std::filesystem::path path(filepath);
   if (!std::filesystem::exists(path.parent_path())) {
@@ -60,78 +216,30 @@ void SceneSerializer::Serialize(const std::string &filepath) {
   json root;
   root["Scene"] = "Untitled";
 
-  json entities = json::array();
-  for (auto &entity : m_Scene->GetEntities()) {
-    json e;
-    e["Entity"] = entity->Name;
-
-    json transform;
-    transform["Position"] = {entity->Transform.Position.x,
-                             entity->Transform.Position.y,
-                             entity->Transform.Position.z};
-    transform["Rotation"] = {entity->Transform.Rotation.x,
-                             entity->Transform.Rotation.y,
-                             entity->Transform.Rotation.z};
-    transform["Scale"] = {entity->Transform.Scale.x, entity->Transform.Scale.y,
-                          entity->Transform.Scale.z};
-    e["Transform"] = transform;
-
-    e["MeshPath"] = MakeRelative(entity->MeshPath);
-    e["ShaderPath"] = entity->MaterialShader
-                          ? MakeRelative(entity->MaterialShader->GetPath())
-                          : "None";
-    e["TexturePath"] = entity->Material.AlbedoMap
-                           ? MakeRelative(entity->Material.AlbedoMap->GetPath())
-                           : "None";
-
-    if (entity->Material.AlbedoMap) {
-      e["TextureTiling"] = {entity->Material.Tiling.x,
-                            entity->Material.Tiling.y};
-    }
+  // Parents are written as positions in the entity array
+  const auto &sceneEntities = m_Scene->GetEntities();
+  std::unordered_map<uint32_t, size_t> positions;
+  for (size_t i = 0; i < sceneEntities.size(); i++)
+    positions[sceneEntities[i]->GetHandle().Value] = i;
 
-    e["Collidable"] = entity->Collidable;
-    e["Anchored"] = entity->Anchored;
-
-    // Tags
-    if (!entity->Tags.empty()) {
-      e["Tags"] = entity->Tags;
-    }
-
-    // Native Scripts
-    if (!entity->Scripts.empty()) {
-      json scripts = json::array();
-      for (const auto &script : entity->Scripts) {
-        json s;
-        s["Name"] = script.Name;
-        scripts.push_back(s);
-      }
-      e["Scripts"] = scripts;
-    }
+  json entities = json::array();
+  for (auto &entity : sceneEntities) {
+    json record = SerializeEntity(entity);
 
-    // Lua Scripts
-    if (!entity->LuaScripts.empty()) {
-      json luaScripts = json::array();
-      for (auto &script : entity->LuaScripts) {
-        luaScripts.push_back(MakeRelative(script.FilePath));
-      }
-      e["LuaScripts"] = luaScripts;
+    // Prefab instances only keep what they override; a missing prefab keeps
+    // the link and the full record
+    json e;
+    if (!entity->PrefabPath.empty()) {
+      e["Prefab"] = MakeRelative(entity->PrefabPath);
+      const json *prefab = LoadPrefab(entity->PrefabPath);
+      e.update(prefab ? Diff(*prefab, record) : record);
+    } else {
+      e = std::move(record);
     }
 
-    if (entity->Name == "Player") {
-      e["CameraFOV"] = entity->CameraFOV;
-      json movement;
-      movement["MaxSpeed"] = entity->Movement.MaxSpeed;
-      movement["MaxSprintSpeed"] = entity->Movement.MaxSprintSpeed;
-      movement["MaxCrouchSpeed"] = entity->Movement.MaxCrouchSpeed;
-      movement["Acceleration"] = entity->Movement.Acceleration;
-      movement["AirAcceleration"] = entity->Movement.AirAcceleration;
-      movement["Friction"] = entity->Movement.Friction;
-      movement["StopSpeed"] = entity->Movement.StopSpeed;
-      movement["JumpVelocity"] = entity->Movement.JumpVelocity;
-      movement["Gravity"] = entity->Movement.Gravity;
-      movement["MaxAirWishSpeed"] = entity->Movement.MaxAirWishSpeed;
-      e["Movement"] = movement;
-    }
+    Ref<Entity> parent = m_Scene->GetParent(entity);
+    if (parent)
+      e["Parent"] = positions[parent->GetHandle().Value];
 
     entities.push_back(e);
   }
@@ -147,6 +255,170 @@ void SceneSerializer::Serialize(const std::string &filepath) {
   }
 }
 
+Ref<VertexArray> SceneSerializer::LoadMesh(const std::string &resolvedPath) {
+  auto it = m_Meshes.find(resolvedPath);
+  if (it != m_Meshes.end())
+    return it->second;
+
+  Ref<VertexArray> mesh;
+  std::filesystem::path extension =
+      std::filesystem::path(resolvedPath).extension();
+  if (extension == ".obj")
+    mesh = MeshLoader::LoadOBJ(resolvedPath);
+  else if (extension == ".stl")
+    mesh = MeshLoader::LoadSTL(resolvedPath);
+  m_Meshes[resolvedPath] = mesh;
+  return mesh;
+}
+
+Ref<Shader> SceneSerializer::LoadShader(const std::string &resolvedPath) {
+  auto it = m_Shaders.find(resolvedPath);
+  if (it != m_Shaders.end())
+    return it->second;
+
+  Ref<Shader> shader = Shader::Create(resolvedPath);
+  m_Shaders[resolvedPath] = shader;
+  return shader;
+}
+
+Ref<Texture2D> SceneSerializer::LoadTexture(const std::string &resolvedPath) {
+  return TextureCache::Load(resolvedPath);
+}
+
+// Seeds the asset caches with what the scene already has loaded, so new
+// entities share it instead of loading their own copy
+void SceneSerializer::ShareSceneAssets() {
+  for (auto &entity : m_Scene->GetEntities()) {
+    if (entity->Mesh && entity->MeshPath != "Cube") {
+      m_Meshes.emplace(
+          Application::Get().ResolveAssetPath(entity->MeshPath).string(),
+          entity->Mesh);
+    }
+    if (entity->MaterialShader)
+      m_Shaders.emplace(entity->MaterialShader->GetPath(),
+                        entity->MaterialShader);
+  }
+}
+
+void SceneSerializer::DeserializeEntity(const json &e,
+                                        const Ref<Entity> &entity) {
+  // Headless runs have no GL context: keep the asset paths but skip the
+  // GPU-side mesh, shader and texture loads
+  bool loadRenderResources = !Application::Get().IsHeadless();
+
+  if (e.contains("Transform")) {
+    auto &t = e["Transform"];
+    if (t.contains("Position")) {
+      entity->Transform.Position = {t["Position"][0], t["Position"][1],
+                                    t["Position"][2]};
+    }
+    if (t.contains("Rotation")) {
+      entity->Transform.Rotation = {t["Rotation"][0], t["Rotation"][1],
+                                    t["Rotation"][2]};
+    }
+    if (t.contains("Scale")) {
+      entity->Transform.Scale = {t["Scale"][0], t["Scale"][1], t["Scale"][2]};
+    }
+  }
+
+  entity->MeshPath = e.value("MeshPath", "");
+  if (entity->MeshPath == "Cube") {
+    entity->Mesh = Application::Get().GetCubeMesh();
+  } else if (loadRenderResources && entity->MeshPath != "" &&
+             entity->MeshPath != "None") {
+    entity->MeshPath =
+        std::filesystem::path(entity->MeshPath).make_preferred().string();
+
+    // Deferred meshes are streamed in by the LevelStreamer
+    if (!m_DeferAssets) {
+      entity->Mesh = LoadMesh(
+          Application::Get().ResolveAssetPath(entity->MeshPath).string());
+    }
+  }
+
+  std::string shaderPath = e.value("ShaderPath", "None");
+  if (loadRenderResources && shaderPath != "None") {
+    std::string resolvedPath =
+        Application::Get().ResolveAssetPath(shaderPath).string();
+    auto defaultShader = Application::Get().GetDefaultShader();
+    if (defaultShader &&
+        (shaderPath.find("Lighting.glsl") != std::string::npos)) {
+      entity->MaterialShader = defaultShader;
+    } else {
+      auto shader = LoadShader(resolvedPath);
+      if (shader)
+        entity->MaterialShader = shader;
+    }
+  }
+
+  std::string texPath = e.value("TexturePath", "None");
+  if (loadRenderResources && texPath != "None") {
+    std::string resolvedPath =
+        Application::Get().ResolveAssetPath(texPath).string();
+    auto defaultTex = Application::Get().GetDefaultTexture();
+    if (defaultTex &&
+        (texPath.find("Checkerboard.png") != std::string::npos)) {
+      entity->Material.AlbedoMap = defaultTex;
+    } else if (m_DeferAssets) {
+      entity->Material.AlbedoPath = resolvedPath;
+    } else {
+      auto texture = LoadTexture(resolvedPath);
+      if (texture)
+        entity->Material.AlbedoMap = texture;
+    }
+  }
+
+  if (e.contains("TextureTiling")) {
+    entity->Material.Tiling = {e["TextureTiling"][0], e["TextureTiling"][1]};
+  }
+
+  entity->Collidable = e.value("Collidable", false);
+  entity->Anchored = e.value("Anchored", false);
+
+  // Tags
+  if (e.contains("Tags")) {
+    for (auto &tag : e["Tags"]) {
+      entity->Tags.push_back(tag.get<std::string>());
+    }
+  }
+
+  // Native Scripts
+  if (e.contains("Scripts")) {
+    for (auto &script : e["Scripts"]) {
+      NativeScriptComponent nsc;
+      nsc.Name = script["Name"].get<std::string>();
+      entity->Scripts.push_back(nsc);
+    }
+  }
+
+  // Lua Scripts
+  if (e.contains("LuaScripts")) {
+    for (auto &luaPath : e["LuaScripts"]) {
+      std::string path = luaPath.get<std::string>();
+      if (!path.empty()) {
+        std::string resolvedPath =
+            Application::Get().ResolveAssetPath(path).string();
+        entity->LuaScripts.push_back({resolvedPath, false});
+      }
+    }
+  }
+
+  if (entity->Name == "Player" && e.contains("Movement")) {
+    entity->CameraFOV = e.value("CameraFOV", 45.0f);
+    auto &m = e["Movement"];
+    entity->Movement.MaxSpeed = m.value("MaxSpeed", 10.0f);
+    entity->Movement.MaxSprintSpeed = m.value("MaxSprintSpeed", 20.0f);
+    entity->Movement.MaxCrouchSpeed = m.value("MaxCrouchSpeed", 5.0f);
+    entity->Movement.Acceleration = m.value("Acceleration", 50.0f);
+    entity->Movement.AirAcceleration = m.value("AirAcceleration", 20.0f);
+    entity->Movement.Friction = m.value("Friction", 6.0f);
+    entity->Movement.StopSpeed = m.value("StopSpeed", 1.0f);
+    entity->Movement.JumpVelocity = m.value("JumpVelocity", 5.0f);
+    entity->Movement.Gravity = m.value("Gravity", 9.81f);
+    entity->Movement.MaxAirWishSpeed = m.value("MaxAirWishSpeed", 30.0f);
+  }
+}
+
 bool SceneSerializer::Deserialize(const std::string &filepath) {
   std::ifstream fin(filepath);
   if (!fin.is_open()) {
@@ -164,124 +436,45 @@ bool SceneSerializer::Deserialize(const std::string &filepath) {
     m_Scene->Clear();
 
     if (data.contains("Entities")) {
-      for (auto &e : data["Entities"]) {
-        Ref<Entity> entity = CreateRef<Entity>();
-        entity->Name = e.value("Entity", "Unnamed Entity");
-
-        if (e.contains("Transform")) {
-          auto &t = e["Transform"];
-          if (t.contains("Position")) {
-            entity->Transform.Position = {t["Position"][0], t["Position"][1],
-                                          t["Position"][2]};
-          }
-          if (t.contains("Rotation")) {
-            entity->Transform.Rotation = {t["Rotation"][0], t["Rotation"][1],
-                                          t["Rotation"][2]};
-          }
-          if (t.contains("Scale")) {
-            entity->Transform.Scale = {t["Scale"][0], t["Scale"][1],
-                                       t["Scale"][2]};
-          }
-        }
-
-        entity->MeshPath = e.value("MeshPath", "");
-        if (entity->MeshPath == "Cube") {
-          entity->Mesh = Application::Get().GetCubeMesh();
-        } else if (entity->MeshPath != "" && entity->MeshPath != "None") {
-          entity->MeshPath =
-              std::filesystem::path(entity->MeshPath).make_preferred().string();
-          std::string resolvedPath =
-              Application::Get().ResolveAssetPath(entity->MeshPath).string();
-
-          if (std::filesystem::path(resolvedPath).extension() == ".obj")
-            entity->Mesh = MeshLoader::LoadOBJ(resolvedPath);
-          else if (std::filesystem::path(resolvedPath).extension() == ".stl")
-            entity->Mesh = MeshLoader::LoadSTL(resolvedPath);
-        }
-
-        std::string shaderPath = e.value("ShaderPath", "None");
-        if (shaderPath != "None") {
-          std::string resolvedPath =
-              Application::Get().ResolveAssetPath(shaderPath).string();
-          auto defaultShader = Application::Get().GetDefaultShader();
-          if (defaultShader &&
-              (shaderPath.find("Lighting.glsl") != std::string::npos)) {
-            entity->MaterialShader = defaultShader;
-          } else {
-            auto shader = Shader::Create(resolvedPath);
-            if (shader)
-              entity->MaterialShader = shader;
-          }
-        }
-
-        std::string texPath = e.value("TexturePath", "None");
-        if (texPath != "None") {
-          std::string resolvedPath =
-              Application::Get().ResolveAssetPath(texPath).string();
-          auto defaultTex = Application::Get().GetDefaultTexture();
-          if (defaultTex &&
-              (texPath.find("Checkerboard.png") != std::string::npos)) {
-            entity->Material.AlbedoMap = defaultTex;
-          } else {
-            auto texture = Texture2D::Create(resolvedPath);
-            if (texture)
-              entity->Material.AlbedoMap = texture;
-          }
-        }
+      std::vector<Ref<Entity>> loaded;
+      std::vector<int64_t> parents;
 
-        if (e.contains("TextureTiling")) {
-          entity->Material.Tiling = {e["TextureTiling"][0],
-                                     e["TextureTiling"][1]};
+      for (auto &e : data["Entities"]) {
+        // Prefab instances are the prefab's record with theirs patched over
+        std::string prefabPath;
+        json record;
+        if (e.contains("Prefab")) {
+          prefabPath = Application::Get()
+                           .ResolveAssetPath(e["Prefab"].get<std::string>())
+                           .string();
+          if (const json *prefab = LoadPrefab(prefabPath))
+            record = *prefab;
+          record.merge_patch(e);
         }
+        const json &fields = prefabPath.empty() ? e : record;
 
-        entity->Collidable = e.value("Collidable", false);
-        entity->Anchored = e.value("Anchored", false);
-
-        // Tags
-        if (e.contains("Tags")) {
-          for (auto &tag : e["Tags"]) {
-            entity->Tags.push_back(tag.get<std::string>());
-          }
-        }
+        Ref<Entity> entity =
+            m_Scene->CreateEntity(fields.value("Entity", "Unnamed Entity"));
+        loaded.push_back(entity);
+        parents.push_back(e.value("Parent", (int64_t)-1));
 
-        // Native Scripts
-        if (e.contains("Scripts")) {
-          for (auto &script : e["Scripts"]) {
-             NativeScriptComponent nsc;
-             nsc.Name = script["Name"];
-             entity->Scripts.push_back(nsc);
-          }
-        }
-
-        // Lua Scripts
-        if (e.contains("LuaScripts")) {
-          for (auto &luaPath : e["LuaScripts"]) {
-            std::string path = luaPath.get<std::string>();
-            if (!path.empty()) {
-              std::string resolvedPath =
-                  Application::Get().ResolveAssetPath(path).string();
-              entity->LuaScripts.push_back({resolvedPath, false});
-            }
-          }
-        }
-
-        if (entity->Name == "Player" && e.contains("Movement")) {
-          entity->CameraFOV = e.value("CameraFOV", 45.0f);
-          auto &m = e["Movement"];
-          entity->Movement.MaxSpeed = m.value("MaxSpeed", 10.0f);
-          entity->Movement.MaxSprintSpeed = m.value("MaxSprintSpeed", 20.0f);
-          entity->Movement.MaxCrouchSpeed = m.value("MaxCrouchSpeed", 5.0f);
-          entity->Movement.Acceleration = m.value("Acceleration", 50.0f);
-          entity->Movement.AirAcceleration = m.value("AirAcceleration", 20.0f);
-          entity->Movement.Friction = m.value("Friction", 6.0f);
-          entity->Movement.StopSpeed = m.value("StopSpeed", 1.0f);
-          entity->Movement.JumpVelocity = m.value("JumpVelocity", 5.0f);
-          entity->Movement.Gravity = m.value("Gravity", 9.81f);
-          entity->Movement.MaxAirWishSpeed = m.value("MaxAirWishSpeed", 30.0f);
-        }
+        DeserializeEntity(fields, entity);
+        entity->PrefabPath = prefabPath;
 
         m_Scene->AddEntity(entity);
       }
+
+      // Link once everything exists; saved Transforms are already local
+      EntityRegistry &registry = m_Scene->GetRegistry();
+      for (size_t i = 0; i < loaded.size(); i++) {
+        if (parents[i] < 0)
+          continue;
+        if (parents[i] >= (int64_t)loaded.size() ||
+            !registry.SetParent(loaded[i]->GetHandle(),
+                                loaded[parents[i]]->GetHandle()))
+          S67_CORE_WARN("Ignoring invalid parent {0} of entity '{1}'",
+                        parents[i], loaded[i]->Name);
+      }
     }
 
     S67_CORE_INFO("Scene loaded from '{0}'", filepath);
@@ -293,4 +486,44 @@ bool SceneSerializer::Deserialize(const std::string &filepath) {
   }
 }
 
+bool SceneSerializer::SerializePrefab(const Ref<Entity> &entity,
+                                      const std::string &filepath) {
+  // Instances are placed individually
+  json record = SerializeEntity(entity);
+  record["Transform"].erase("Position");
+
+  json root;
+  root["Prefab"] = record;
+
+  std::ofstream fout(filepath);
+  if (!fout.is_open()) {
+    S67_CORE_ERROR("Failed to open file '{0}' for saving", filepath);
+    return false;
+  }
+  fout << root.dump(2);
+  fout.close();
+
+  std::string resolvedPath =
+      Application::Get().ResolveAssetPath(filepath).string();
+  s_Prefabs.erase(resolvedPath);
+  entity->PrefabPath = resolvedPath;
+  S67_CORE_INFO("Prefab saved to '{0}'", filepath);
+  return true;
+}
+
+Ref<Entity> SceneSerializer::InstantiatePrefab(const std::string &filepath) {
+  std::string resolvedPath =
+      Application::Get().ResolveAssetPath(filepath).string();
+  const json *prefab = LoadPrefab(resolvedPath);
+  if (!prefab)
+    return nullptr;
+
+  ShareSceneAssets();
+  Ref<Entity> entity =
+      m_Scene->CreateEntity(prefab->value("Entity", "Unnamed Entity"));
+  DeserializeEntity(*prefab, entity);
+  entity->PrefabPath = resolvedPath;
+  return entity;
+}
+
 } // namespace S67
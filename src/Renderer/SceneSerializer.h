@@ -1,21 +1,62 @@
 #pragma once
 
 #include "Scene.h"
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <unordered_map>
 
 namespace S67 {
 
+/**
+ * @brief Reads and writes .s67 levels and .s67prefab prefabs
+ *
+ * A prefab is one entity record (mesh, material, scripts, flags) without a
+ * position. Entities instantiated from one keep its path, and levels store
+ * them as a reference plus only the fields they override, so editing the
+ * prefab updates every instance the next time the level is loaded.
+ *
+ * Meshes and shaders are loaded once per serializer and shared by every
+ * entity that names the same file. Textures come from the TextureCache, so
+ * they are also shared with the rest of the engine.
+ */
 class SceneSerializer {
 public:
   SceneSerializer(Scene *scene, const std::string &projectRoot = "");
 
   void Serialize(const std::string &filepath);
   bool Deserialize(const std::string &filepath);
+  // Deserialize records mesh and texture paths without loading them, leaving
+  // them for the LevelStreamer to bring in around the camera
+  void SetDeferAssets(bool defer) { m_DeferAssets = defer; }
+
+  // Writes the entity out as a prefab and links it to the new file
+  bool SerializePrefab(const Ref<Entity> &entity, const std::string &filepath);
+  // New entity from a prefab, not yet added to the scene: the caller places
+  // it, creates its physics body and calls Scene::AddEntity. Assets already
+  // used in the scene are shared. Returns nullptr if the prefab can't be read.
+  Ref<Entity> InstantiatePrefab(const std::string &filepath);
+
+  static constexpr const char *PREFAB_EXTENSION = ".s67prefab";
 
 private:
   std::string MakeRelative(const std::string &path);
 
+  nlohmann::ordered_json SerializeEntity(const Ref<Entity> &entity);
+  void DeserializeEntity(const nlohmann::ordered_json &record,
+                         const Ref<Entity> &entity);
+
+  Ref<VertexArray> LoadMesh(const std::string &resolvedPath);
+  Ref<Shader> LoadShader(const std::string &resolvedPath);
+  Ref<Texture2D> LoadTexture(const std::string &resolvedPath);
+  void ShareSceneAssets();
+
   Scene *m_Scene;
   std::string m_ProjectRoot;
+  bool m_DeferAssets = false;
+
+  // Resolved path -> loaded asset (nullptr if loading failed)
+  std::unordered_map<std::string, Ref<VertexArray>> m_Meshes;
+  std::unordered_map<std::string, Ref<Shader>> m_Shaders;
 };
 
 } // namespace S67
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Core/ObjectArena.h"
 #include "Renderer/Entity.h"
 #include "Renderer/ScriptableEntity.h"
 #include <functional>
@@ -12,7 +13,7 @@ namespace S67 {
 
 class ScriptRegistry {
 public:
-  using InstantiateFunc = std::function<ScriptableEntity *()>;
+  using InstantiateFunc = std::function<ScriptableEntity *(ObjectArena &)>;
 
   static ScriptRegistry &Get() {
     static ScriptRegistry instance;
@@ -20,15 +21,18 @@ public:
   }
 
   template <typename T> void Register(const std::string &name) {
-    m_Registry[name] = []() { return static_cast<ScriptableEntity *>(new T()); };
+    m_Registry[name] = [](ObjectArena &arena) {
+      return static_cast<ScriptableEntity *>(arena.Create<T>());
+    };
     if (m_IsLoadingModule) {
       m_DynamicScriptNames.push_back(name);
     }
   }
 
-  ScriptableEntity *Instantiate(const std::string &name) {
+  // The instance lives until the arena is reset (Scene::Clear)
+  ScriptableEntity *Instantiate(const std::string &name, ObjectArena &arena) {
     if (m_Registry.find(name) != m_Registry.end()) {
-      return m_Registry[name]();
+      return m_Registry[name](arena);
     }
     return nullptr;
   }
@@ -39,14 +43,7 @@ public:
 
   void Bind(const std::string &name, NativeScriptComponent &nsc) {
     if (m_Registry.find(name) != m_Registry.end()) {
-      nsc.Name = name;
-      nsc.InstantiateScript = [](NativeScriptComponent *nsc_ptr) -> ScriptableEntity * {
-          return ScriptRegistry::Get().Instantiate(nsc_ptr->Name);
-      };
-      nsc.DestroyScript = [](NativeScriptComponent *nsc_ptr) {
-        delete nsc_ptr->Instance;
-        nsc_ptr->Instance = nullptr;
-      };
+      nsc.Name = name; // Instantiated by name through Instantiate()
     }
   }
 
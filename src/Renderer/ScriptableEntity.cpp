@@ -6,6 +6,17 @@
 
 namespace S67 {
 
+static std::vector<Entity *>
+ResolveEntities(const Scene &scene, const std::vector<EntityHandle> &handles) {
+  std::vector<Entity *> entities;
+  entities.reserve(handles.size());
+  for (EntityHandle handle : handles) {
+    if (Ref<Entity> entity = scene.GetEntity(handle))
+      entities.push_back(entity.get());
+  }
+  return entities;
+}
+
 Entity &ScriptableEntity::GetEntity() { return *m_Entity; }
 Transform &ScriptableEntity::GetTransform() { return m_Entity->Transform; }
 
@@ -13,15 +24,11 @@ Entity *ScriptableEntity::Raycast(float distance) {
   JPH::BodyID bodyID = PhysicsSystem::Raycast(m_Entity->Transform.Position,
                                               m_Entity->Transform.Rotation * glm::vec3(0, 0, -1), // Forward vector
                                               distance);
-  // mapping bodyID to Entity is needed here, but for now let's just return nullptr if no hit or we need a way to look it up.
-  // Actually, PhysicsSystem::Raycast returns a BodyID. We need to map it back.
-  // For the purpose of "Stupid Simple" API, maybe we return the Entity* if we can find it.
-  // But PhysicsSystem in this engine might not natively map BodyID -> Entity* easily without lookup.
-  // Let's assume for now we just want to know if we hit something, or maybe PhysicsSystem needs a helper.
-  // Allow me to check PhysicsSystem.h again? No, I saw it.
-  // Wait, Raycast in PhysicsSystem.h returns BodyID.
-  // Let's just return nullptr for now or fix it properly later.
-  return nullptr;
+  // Bodies carry their entity's handle; deleted entities resolve to nullptr
+  return Application::Get()
+      .GetScene()
+      .GetEntity(PhysicsSystem::GetBodyEntity(bodyID))
+      .get();
 }
 
 void ScriptableEntity::SetText(const std::string &id, const std::string &text,
@@ -44,11 +51,15 @@ bool ScriptableEntity::HasTag(const std::string &tag) {
 }
 
 Entity *ScriptableEntity::FindEntity(const std::string &name) {
-  // This would typically involve searching the scene.
-  // For now, let's assume we have access to the scene or a registry.
   return Application::Get().GetScene().FindEntityByName(name).get();
 }
 
+std::vector<Entity *>
+ScriptableEntity::FindEntitiesWithTag(const std::string &tag) {
+  Scene &scene = Application::Get().GetScene();
+  return ResolveEntities(scene, scene.FindEntitiesByTag(tag));
+}
+
 void ScriptableEntity::Move(const glm::vec3 &delta) {
   m_Entity->Transform.Position += delta;
 }
@@ -76,6 +87,55 @@ void ScriptableEntity::Rotate(Entity *other, const glm::vec3 &eulerDelta) {
     other->Transform.Rotation += eulerDelta;
 }
 
+std::vector<Entity *>
+ScriptableEntity::FindEntitiesInRadius(const glm::vec3 &center, float radius) {
+  Scene &scene = Application::Get().GetScene();
+  std::vector<EntityHandle> handles;
+  scene.GetRegistry().QuerySphere(center, radius, handles);
+  return ResolveEntities(scene, handles);
+}
+
+std::vector<Entity *> ScriptableEntity::FindEntitiesInBox(const glm::vec3 &min,
+                                                          const glm::vec3 &max) {
+  Scene &scene = Application::Get().GetScene();
+  std::vector<EntityHandle> handles;
+  scene.GetRegistry().QueryBox({min, max}, handles);
+  return ResolveEntities(scene, handles);
+}
+
+std::vector<Entity *>
+ScriptableEntity::FindEntitiesInView(const glm::mat4 &viewProjection) {
+  Scene &scene = Application::Get().GetScene();
+  std::vector<EntityHandle> handles;
+  scene.GetRegistry().QueryFrustum(Frustum::FromMatrix(viewProjection),
+                                   handles);
+  return ResolveEntities(scene, handles);
+}
+
+Entity *ScriptableEntity::FindNearestEntity(float maxDistance,
+                                            const std::string &tag) {
+  Scene &scene = Application::Get().GetScene();
+  const EntityRegistry &registry = scene.GetRegistry();
+  EntityHandle self = m_Entity->GetHandle();
+  EntityHandle nearest = registry.FindNearest(
+      glm::vec3(registry.GetWorldTransform(self)[3]), maxDistance,
+      [&](EntityHandle handle) {
+        return handle != self && (tag.empty() || registry.HasTag(handle, tag));
+      });
+  return scene.GetEntity(nearest).get();
+}
+
+Entity *ScriptableEntity::RaycastEntities(const glm::vec3 &origin,
+                                          const glm::vec3 &direction,
+                                          float distance) {
+  Scene &scene = Application::Get().GetScene();
+  EntityHandle self = m_Entity->GetHandle();
+  EntityHandle hit = scene.GetRegistry().Raycast(
+      origin, direction, distance, nullptr,
+      [self](EntityHandle handle) { return handle != self; });
+  return scene.GetEntity(hit).get();
+}
+
 bool ScriptableEntity::IsKeyPressed(int key) {
   return Input::IsKeyPressed(key);
 }
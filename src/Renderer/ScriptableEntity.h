@@ -2,6 +2,7 @@
 
 #include "Events/Event.h"
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace S67 {
@@ -28,6 +29,7 @@ public:
 
   // Discovery & Manipulation
   Entity *FindEntity(const std::string &name);
+  std::vector<Entity *> FindEntitiesWithTag(const std::string &tag);
   void Move(const glm::vec3 &delta);
   void Move(Entity *other, const glm::vec3 &delta);
   void SetPosition(const glm::vec3 &pos);
@@ -35,6 +37,17 @@ public:
   void Rotate(const glm::vec3 &eulerDelta);
   void Rotate(Entity *other, const glm::vec3 &eulerDelta);
 
+  // Spatial queries against entity bounds, as of the end of the last tick.
+  // The calling entity is never returned by the nearest/raycast queries.
+  std::vector<Entity *> FindEntitiesInRadius(const glm::vec3 &center,
+                                             float radius);
+  std::vector<Entity *> FindEntitiesInBox(const glm::vec3 &min,
+                                          const glm::vec3 &max);
+  std::vector<Entity *> FindEntitiesInView(const glm::mat4 &viewProjection);
+  Entity *FindNearestEntity(float maxDistance, const std::string &tag = "");
+  Entity *RaycastEntities(const glm::vec3 &origin, const glm::vec3 &direction,
+                          float distance = 100.0f);
+
   // Input
   bool IsKeyPressed(int key);
 
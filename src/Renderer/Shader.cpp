@@ -3,6 +3,7 @@
 #include "Core/Logger.h"
 #include <fstream>
 #include <glad/glad.h>
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp>
 #include <vector>
 
@@ -55,7 +56,8 @@ Shader::~Shader() {
 Shader::Shader(Shader&& other) noexcept
     : m_RendererID(other.m_RendererID),
       m_Name(std::move(other.m_Name)),
-      m_FilePath(std::move(other.m_FilePath)) {
+      m_FilePath(std::move(other.m_FilePath)),
+      m_UniformLocations(std::move(other.m_UniformLocations)) {
   other.m_RendererID = 0;
 }
 
@@ -71,6 +73,7 @@ Shader& Shader::operator=(Shader&& other) noexcept {
     m_RendererID = other.m_RendererID;
     m_Name = std::move(other.m_Name);
     m_FilePath = std::move(other.m_FilePath);
+    m_UniformLocations = std::move(other.m_UniformLocations);
     
     // Nullify moved-from object
     other.m_RendererID = 0;
@@ -124,34 +127,92 @@ void Shader::Bind() const { glUseProgram(m_RendererID); }
 
 void Shader::Unbind() const { glUseProgram(0); }
 
-void Shader::SetInt(const std::string &name, int value) {
-  GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-  glUniform1i(location, value);
+void Shader::SetInt(std::string_view name, int value) {
+  glUniform1i(GetUniformLocation(name), value);
 }
 
-void Shader::SetFloat(const std::string &name, float value) {
-  GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-  glUniform1f(location, value);
+void Shader::SetFloat(std::string_view name, float value) {
+  glUniform1f(GetUniformLocation(name), value);
 }
 
-void Shader::SetFloat2(const std::string &name, const glm::vec2 &value) {
-  GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-  glUniform2f(location, value.x, value.y);
+void Shader::SetFloat2(std::string_view name, const glm::vec2 &value) {
+  glUniform2f(GetUniformLocation(name), value.x, value.y);
 }
 
-void Shader::SetFloat3(const std::string &name, const glm::vec3 &value) {
-  GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-  glUniform3f(location, value.x, value.y, value.z);
+void Shader::SetFloat3(std::string_view name, const glm::vec3 &value) {
+  glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
 }
 
-void Shader::SetFloat4(const std::string &name, const glm::vec4 &value) {
-  GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-  glUniform4f(location, value.x, value.y, value.z, value.w);
+void Shader::SetFloat4(std::string_view name, const glm::vec4 &value) {
+  glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
 }
 
-void Shader::SetMat4(const std::string &name, const glm::mat4 &value) {
-  GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-  glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+void Shader::SetMat4(std::string_view name, const glm::mat4 &value) {
+  glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE,
+                     glm::value_ptr(value));
+}
+
+int32_t Shader::GetUniformLocation(std::string_view name) const {
+  auto it = m_UniformLocations.find(name);
+  return it != m_UniformLocations.end() ? it->second : -1;
+}
+
+void Shader::Set(UniformHandle<int> uniform, int value) {
+  glUniform1i(uniform.Location, value);
+}
+
+void Shader::Set(UniformHandle<float> uniform, float value) {
+  glUniform1f(uniform.Location, value);
+}
+
+void Shader::Set(UniformHandle<glm::vec2> uniform, const glm::vec2 &value) {
+  glUniform2f(uniform.Location, value.x, value.y);
+}
+
+void Shader::Set(UniformHandle<glm::vec3> uniform, const glm::vec3 &value) {
+  glUniform3f(uniform.Location, value.x, value.y, value.z);
+}
+
+void Shader::Set(UniformHandle<glm::vec4> uniform, const glm::vec4 &value) {
+  glUniform4f(uniform.Location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::Set(UniformHandle<glm::mat4> uniform, const glm::mat4 &value) {
+  glUniformMatrix4fv(uniform.Location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+// Every active uniform goes into the name table once after linking, so
+// setting one never asks the driver. Arrays are listed as "name[0]" and
+// are also entered under their bare name.
+void Shader::ReflectUniforms() {
+  m_UniformLocations.clear();
+
+  GLint count = 0;
+  GLint maxLength = 0;
+  glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+  if (count <= 0)
+    return;
+
+  std::vector<GLchar> buffer(std::max(maxLength, 1));
+  m_UniformLocations.reserve(count);
+  for (GLint i = 0; i < count; i++) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type = 0;
+    glGetActiveUniform(m_RendererID, (GLuint)i, (GLsizei)buffer.size(),
+                       &length, &size, &type, buffer.data());
+    std::string name(buffer.data(), length);
+
+    // Block members have no location of their own
+    GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+    if (location < 0)
+      continue;
+
+    m_UniformLocations[name] = location;
+    if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+      m_UniformLocations[name.substr(0, name.size() - 3)] = location;
+  }
 }
 
 void Shader::Compile(
@@ -223,6 +284,12 @@ void Shader::Compile(
   }
 
   m_RendererID = program;
+  ReflectUniforms();
+
+  GLuint frameBlock = glGetUniformBlockIndex(program, "Frame");
+  if (frameBlock != GL_INVALID_INDEX)
+    glUniformBlockBinding(program, frameBlock,
+                          (GLuint)UniformBlockBinding::Frame);
 }
 
 Ref<Shader> Shader::Create(const std::string &filepath) {
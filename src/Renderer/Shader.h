@@ -2,12 +2,29 @@
 
 #include "Core/Base.h"
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
-
 namespace S67 {
 
+// Binding points of the uniform blocks every program may declare; they are
+// attached at link time, so shaders need no layout(binding) qualifier
+enum class UniformBlockBinding : uint32_t {
+  Frame = 0, // Camera, sun, viewport and time (see Renderer)
+};
+
+// Pre-resolved location of a uniform of type T, from Shader::GetUniform().
+// Hot paths look their uniforms up once and keep these; a handle to a
+// uniform the program doesn't use (location -1) is ignored when set.
+template <typename T> struct UniformHandle {
+  int32_t Location = -1;
+
+  bool IsValid() const { return Location >= 0; }
+};
+
 class Shader {
 public:
   Shader(const std::string &filepath);
@@ -26,15 +43,33 @@ public:
   void Bind() const;
   void Unbind() const;
 
-  void SetInt(const std::string &name, int value);
-  void SetFloat(const std::string &name, float value);
-  void SetFloat2(const std::string &name, const glm::vec2 &value);
-  void SetFloat3(const std::string &name, const glm::vec3 &value);
-  void SetFloat4(const std::string &name, const glm::vec4 &value);
-  void SetMat4(const std::string &name, const glm::mat4 &value);
+  // By name, looked up in the table reflected at link time. The program
+  // must be bound.
+  void SetInt(std::string_view name, int value);
+  void SetFloat(std::string_view name, float value);
+  void SetFloat2(std::string_view name, const glm::vec2 &value);
+  void SetFloat3(std::string_view name, const glm::vec3 &value);
+  void SetFloat4(std::string_view name, const glm::vec4 &value);
+  void SetMat4(std::string_view name, const glm::mat4 &value);
+
+  // Location of an active uniform, -1 if the program has none by that name
+  int32_t GetUniformLocation(std::string_view name) const;
+  template <typename T>
+  UniformHandle<T> GetUniform(std::string_view name) const {
+    return {GetUniformLocation(name)};
+  }
+
+  // By handle, without any lookup. The program must be bound.
+  void Set(UniformHandle<int> uniform, int value);
+  void Set(UniformHandle<float> uniform, float value);
+  void Set(UniformHandle<glm::vec2> uniform, const glm::vec2 &value);
+  void Set(UniformHandle<glm::vec3> uniform, const glm::vec3 &value);
+  void Set(UniformHandle<glm::vec4> uniform, const glm::vec4 &value);
+  void Set(UniformHandle<glm::mat4> uniform, const glm::mat4 &value);
 
   const std::string &GetName() const { return m_Name; }
   const std::string &GetPath() const { return m_FilePath; }
+  uint32_t GetRendererID() const { return m_RendererID; }
   bool IsValid() const { return m_RendererID != 0; }
 
   static Ref<Shader> Create(const std::string &filepath);
@@ -48,10 +83,21 @@ private:
   PreProcess(const std::string &source);
   void
   Compile(const std::unordered_map<unsigned int, std::string> &shaderSources);
+  void ReflectUniforms();
+
+  // Lets the uniform table be searched by string_view without a copy
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>()(name);
+    }
+  };
 
   uint32_t m_RendererID = 0;
   std::string m_Name;
   std::string m_FilePath;
+  std::unordered_map<std::string, int32_t, NameHash, std::equal_to<>>
+      m_UniformLocations;
 };
 
 class ShaderLibrary {
@@ -42,13 +42,9 @@ Skybox::Skybox(const std::string &texturePath) {
   m_VertexArray->SetIndexBuffer(ibo);
 }
 
-void Skybox::Draw(const Camera &camera) {
+void Skybox::Draw() {
   glDepthFunc(GL_LEQUAL);
   m_Shader->Bind();
-  // Remove translation from view matrix for skybox
-  glm::mat4 view = camera.GetViewMatrix();
-  view[3] = glm::vec4(0, 0, 0, 1);
-  m_Shader->SetMat4("u_ViewProjection", camera.GetProjectionMatrix() * view);
   m_Shader->SetMat4("u_Transform", glm::mat4(1.0f));
   m_Texture->Bind(0);
   m_Shader->SetInt("u_SkyboxTexture", 0);
@@ -3,7 +3,6 @@
 #include "Renderer/VertexArray.h"
 #include "Renderer/Shader.h"
 #include "Renderer/Texture.h"
-#include "Renderer/Camera.h"
 
 namespace S67 {
 
@@ -20,7 +19,8 @@ namespace S67 {
         Skybox(Skybox&&) noexcept = default;
         Skybox& operator=(Skybox&&) noexcept = default;
 
-        void Draw(const Camera& camera);
+        // With the camera of the current Renderer scene, centred on it
+        void Draw();
 
     private:
         Ref<VertexArray> m_VertexArray;
@@ -0,0 +1,373 @@
+#include "StaticGeometry.h"
+#include "Core/Logger.h"
+#include "Core/Timer.h"
+#include "Game/Console/ConVar.h"
+#include "Renderer/Entity.h"
+#include "Renderer/LevelStreamer.h"
+#include "Renderer/Mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace S67 {
+
+static ConVar r_staticbatch(
+    "r_staticbatch", "1", FCVAR_ARCHIVE,
+    "Merge anchored, script-free entities into per-cell static batches");
+static ConVar r_staticbatch_cell(
+    "r_staticbatch_cell", "32", FCVAR_ARCHIVE,
+    "Edge length of a static batch cell while streaming is off (batches "
+    "follow the streaming chunks otherwise)",
+    true, 1.0f, false, 0.0f);
+
+// Floats per vertex: position (3), normal (3), texcoord (2), as MeshLoader
+// lays them out
+static constexpr uint32_t VERTEX_FLOATS = 8;
+
+bool StaticGeometry::IsEnabled() { return r_staticbatch.GetBool(); }
+
+void StaticGeometry::Clear() {
+  m_Batches.clear();
+  m_FreeBatches.clear();
+  m_Members.clear();
+  m_Singles.clear();
+  m_DirtyCells.clear();
+  m_Statistics = Statistics();
+  m_RebuildAll = true;
+}
+
+bool StaticGeometry::IsCandidate(const Entity &entity) {
+  if (!entity.Anchored || !entity.Scripts.empty() ||
+      !entity.LuaScripts.empty())
+    return false;
+  // A texture still streaming in would evict the entity once it arrives
+  if (!entity.Mesh || !entity.MaterialShader ||
+      !entity.MaterialShader->IsValid() ||
+      !entity.Material.AlbedoPath.empty())
+    return false;
+
+  const VertexArray &mesh = *entity.Mesh;
+  const auto &buffers = mesh.GetVertexBuffers();
+  return buffers.size() == 1 &&
+         buffers[0]->GetLayout().GetStride() ==
+             VERTEX_FLOATS * sizeof(float) &&
+         mesh.GetIndexBuffer() && mesh.GetIndexBuffer()->GetCount() > 0;
+}
+
+// Tolerates the rounding between the editor's cached world matrices and the
+// ones rebuilt from interpolated tick states
+static bool NearlyEqual(const glm::mat4 &a, const glm::mat4 &b) {
+  for (int column = 0; column < 4; column++) {
+    glm::vec4 difference = glm::abs(a[column] - b[column]);
+    glm::vec4 tolerance = 1e-4f + 1e-5f * glm::abs(a[column]);
+    if (glm::any(glm::greaterThan(difference, tolerance)))
+      return false;
+  }
+  return true;
+}
+
+// Identity even after the merged object is gone: the weak reference keeps
+// its control block, so a new object can't alias it
+template <typename T>
+static bool SameObject(const std::weak_ptr<T> &merged, const Ref<T> &current) {
+  return !merged.owner_before(current) && !current.owner_before(merged);
+}
+
+bool StaticGeometry::StillMatches(const Entity &entity,
+                                  const glm::mat4 &transform,
+                                  const Member &member) {
+  return entity.Anchored && entity.Scripts.empty() &&
+         entity.LuaScripts.empty() && entity.Material.AlbedoPath.empty() &&
+         SameObject(member.Mesh, entity.Mesh) &&
+         SameObject(member.MaterialShader, entity.MaterialShader) &&
+         SameObject(member.Albedo, entity.Material.AlbedoMap) &&
+         entity.Material.Tiling == member.Tiling &&
+         NearlyEqual(transform, member.Transform);
+}
+
+int64_t StaticGeometry::GetCell(const glm::mat4 &transform) const {
+  glm::vec3 origin = glm::vec3(transform[3]);
+  if (m_Streamer)
+    return m_Streamer->GetChunkKey(origin);
+
+  int32_t x = (int32_t)std::floor(origin.x / m_CellSize);
+  int32_t z = (int32_t)std::floor(origin.z / m_CellSize);
+  return ((int64_t)x << 32) | (uint32_t)z;
+}
+
+void StaticGeometry::MarkDirty(int64_t cell) { m_DirtyCells[cell] = m_Stamp; }
+
+void StaticGeometry::Update(const std::vector<Ref<Entity>> &entities,
+                            const std::vector<glm::mat4> &transforms,
+                            const LevelStreamer &streamer) {
+  if (!IsEnabled()) {
+    if (!m_Batches.empty() || !m_Singles.empty())
+      Clear();
+    return;
+  }
+
+  // Batches are cut along the streaming chunks, so a chunk that streams out
+  // releases whole batches rather than leaving holes in its neighbours'
+  const LevelStreamer *grid = LevelStreamer::IsEnabled() ? &streamer : nullptr;
+  float cellSize = r_staticbatch_cell.GetFloat();
+  if (grid != m_Streamer || (!grid && cellSize != m_CellSize)) {
+    m_Streamer = grid;
+    m_CellSize = cellSize;
+    m_RebuildAll = true;
+  }
+
+  if (m_RebuildAll) {
+    Timer timer;
+    Clear();
+    m_RebuildAll = false;
+    Rebuild(entities, transforms, nullptr);
+    if (m_Statistics.Batches > 0) {
+      S67_CORE_INFO(
+          "Merged {0} static entities into {1} batches in {2:.2f} ms",
+          m_Statistics.Merged, m_Statistics.Batches, timer.ElapsedMillis());
+    }
+    return;
+  }
+
+  m_DueCells.clear();
+  for (auto it = m_DirtyCells.begin(); it != m_DirtyCells.end();) {
+    if (m_Stamp - it->second < SETTLE_FRAMES) {
+      ++it;
+      continue;
+    }
+    m_DueCells.insert(it->first);
+    it = m_DirtyCells.erase(it);
+  }
+  if (!m_DueCells.empty())
+    Rebuild(entities, transforms, &m_DueCells);
+  m_Statistics.DirtyCells = (uint32_t)m_DirtyCells.size();
+}
+
+void StaticGeometry::Rebuild(const std::vector<Ref<Entity>> &entities,
+                             const std::vector<glm::mat4> &transforms,
+                             const std::unordered_set<int64_t> *cells) {
+  auto inCells = [cells](int64_t cell) {
+    return !cells || cells->count(cell) > 0;
+  };
+
+  // Whatever the cells held is replaced
+  for (uint32_t b = 0; b < m_Batches.size(); b++) {
+    Batch &batch = m_Batches[b];
+    if (!batch.Mesh || !inCells(batch.Cell))
+      continue;
+    for (const Member &member : batch.Members) {
+      if (!member.Evicted)
+        m_Members.erase(member.Handle.Value);
+    }
+    m_Statistics.Merged -= batch.LiveMembers;
+    batch.LiveMembers = 0;
+    Release(b);
+  }
+  for (auto it = m_Singles.begin(); it != m_Singles.end();) {
+    if (inCells(it->second.Cell))
+      it = m_Singles.erase(it);
+    else
+      ++it;
+  }
+
+  // Shader, texture, cell -> entity indices. Ordered so batches come out the
+  // same for the same level.
+  using GroupKey = std::tuple<const Shader *, const Texture2D *, int64_t>;
+  std::map<GroupKey, std::vector<size_t>> groups;
+  for (size_t i = 0; i < entities.size() && i < transforms.size(); i++) {
+    const Entity &entity = *entities[i];
+    if (!IsCandidate(entity))
+      continue;
+
+    int64_t cell = GetCell(transforms[i]);
+    if (!inCells(cell))
+      continue;
+    GroupKey key(entity.MaterialShader.get(), entity.Material.AlbedoMap.get(),
+                 cell);
+    groups[key].push_back(i);
+  }
+
+  // Source meshes are read back once however many entities share them
+  std::unordered_map<const VertexArray *, MeshData> sources;
+  auto readBack = [&](const VertexArray &mesh) -> const MeshData & {
+    auto [it, inserted] = sources.try_emplace(&mesh);
+    if (inserted) {
+      const Ref<VertexBuffer> &vertices = mesh.GetVertexBuffers()[0];
+      const Ref<IndexBuffer> &indices = mesh.GetIndexBuffer();
+      it->second.Vertices.resize(vertices->GetSize() / sizeof(float));
+      vertices->GetData(it->second.Vertices.data(), vertices->GetSize());
+      it->second.Indices.resize(indices->GetCount());
+      indices->GetData(it->second.Indices.data(), indices->GetCount());
+    }
+    return it->second;
+  };
+
+  MeshData merged;
+  for (const auto &group : groups) {
+    const std::vector<size_t> &members = group.second;
+    int64_t cell = std::get<2>(group.first);
+
+    auto record = [&](size_t index) {
+      const Entity &entity = *entities[index];
+      Member member;
+      member.Handle = entity.GetHandle();
+      member.Transform = transforms[index];
+      member.Mesh = entity.Mesh;
+      member.MaterialShader = entity.MaterialShader;
+      member.Albedo = entity.Material.AlbedoMap;
+      member.Tiling = entity.Material.Tiling;
+      member.SeenStamp = m_Stamp;
+      return member;
+    };
+
+    // Left alone, but remembered so it doesn't keep its cell dirty
+    if (members.size() < 2) {
+      m_Singles[entities[members[0]]->GetHandle().Value] = {
+          record(members[0]), cell};
+      continue;
+    }
+
+    const Entity &first = *entities[members[0]];
+    Batch batch;
+    batch.MaterialShader = first.MaterialShader;
+    batch.Albedo = first.Material.AlbedoMap;
+    batch.Textured = first.Material.AlbedoMap != nullptr;
+    batch.Cell = cell;
+    batch.Members.reserve(members.size());
+
+    merged.Vertices.clear();
+    merged.Indices.clear();
+    for (size_t index : members) {
+      const Entity &entity = *entities[index];
+      const glm::mat4 &transform = transforms[index];
+      const MeshData &source = readBack(*entity.Mesh);
+      glm::mat3 normalMatrix =
+          glm::transpose(glm::inverse(glm::mat3(transform)));
+      glm::vec2 tiling = entity.Material.Tiling;
+
+      Member member = record(index);
+      member.FirstIndex = (uint32_t)merged.Indices.size();
+      member.IndexCount = (uint32_t)source.Indices.size();
+
+      uint32_t baseVertex = (uint32_t)(merged.Vertices.size() / VERTEX_FLOATS);
+      for (size_t v = 0; v + VERTEX_FLOATS <= source.Vertices.size();
+           v += VERTEX_FLOATS) {
+        const float *in = &source.Vertices[v];
+        glm::vec3 position =
+            glm::vec3(transform * glm::vec4(in[0], in[1], in[2], 1.0f));
+        glm::vec3 normal = normalMatrix * glm::vec3(in[3], in[4], in[5]);
+        float length = glm::length(normal);
+        if (length > 0.0f)
+          normal /= length;
+        merged.Vertices.insert(merged.Vertices.end(),
+                               {position.x, position.y, position.z, normal.x,
+                                normal.y, normal.z, in[6] * tiling.x,
+                                in[7] * tiling.y});
+      }
+      for (uint32_t i : source.Indices)
+        merged.Indices.push_back(baseVertex + i);
+
+      AABB bounds = entity.Mesh->GetBounds().Transformed(transform);
+      batch.Bounds = batch.Members.empty() ? bounds
+                                           : AABB::Merge(batch.Bounds, bounds);
+      batch.Members.push_back(member);
+    }
+
+    merged.Bounds = batch.Bounds;
+    merged.Sphere = {batch.Bounds.GetCenter(),
+                     glm::length(batch.Bounds.GetExtents())};
+    batch.Mesh = MeshLoader::Upload(merged);
+    batch.LiveMembers = (uint32_t)batch.Members.size();
+
+    uint32_t batchIndex;
+    if (!m_FreeBatches.empty()) {
+      batchIndex = m_FreeBatches.back();
+      m_FreeBatches.pop_back();
+    } else {
+      batchIndex = (uint32_t)m_Batches.size();
+      m_Batches.emplace_back();
+    }
+    for (uint32_t m = 0; m < batch.Members.size(); m++)
+      m_Members[batch.Members[m].Handle.Value] = {batchIndex, m};
+    m_Statistics.Merged += batch.LiveMembers;
+    m_Statistics.Batches++;
+    m_Batches[batchIndex] = std::move(batch);
+  }
+}
+
+bool StaticGeometry::Covers(const Entity &entity, const glm::mat4 &transform) {
+  uint32_t key = entity.GetHandle().Value;
+  if (auto it = m_Members.find(key); it != m_Members.end()) {
+    Batch &batch = m_Batches[it->second.Batch];
+    Member &member = batch.Members[it->second.Member];
+    member.SeenStamp = m_Stamp;
+    if (StillMatches(entity, transform, member))
+      return true;
+
+    Evict(it->second);
+    m_Members.erase(it);
+  } else if (auto single = m_Singles.find(key); single != m_Singles.end()) {
+    if (StillMatches(entity, transform, single->second.Record)) {
+      single->second.Record.SeenStamp = m_Stamp;
+      return false;
+    }
+    m_Singles.erase(single);
+  }
+
+  // Could be merged where it is now: new, edited, or streamed back in
+  if (IsEnabled() && IsCandidate(entity))
+    MarkDirty(GetCell(transform));
+  return false;
+}
+
+void StaticGeometry::EvictUnseen() {
+  for (auto it = m_Members.begin(); it != m_Members.end();) {
+    const MemberIndex &index = it->second;
+    if (m_Batches[index.Batch].Members[index.Member].SeenStamp == m_Stamp) {
+      ++it;
+      continue;
+    }
+    Evict(index);
+    it = m_Members.erase(it);
+  }
+  for (auto it = m_Singles.begin(); it != m_Singles.end();) {
+    if (it->second.Record.SeenStamp == m_Stamp)
+      ++it;
+    else
+      it = m_Singles.erase(it);
+  }
+  m_Stamp++;
+}
+
+void StaticGeometry::Evict(const MemberIndex &index) {
+  Batch &batch = m_Batches[index.Batch];
+  Member &member = batch.Members[index.Member];
+
+  // Degenerate triangles: the range stays in the buffer but draws nothing
+  std::vector<uint32_t> cleared(member.IndexCount, 0);
+  batch.Mesh->GetIndexBuffer()->SetData(cleared.data(), member.IndexCount,
+                                        member.FirstIndex);
+  member.Evicted = true;
+
+  m_Statistics.Merged--;
+  m_Statistics.Evicted++;
+  MarkDirty(batch.Cell);
+  if (--batch.LiveMembers == 0)
+    Release(index.Batch);
+}
+
+void StaticGeometry::Release(uint32_t batchIndex) {
+  Batch &batch = m_Batches[batchIndex];
+  batch = Batch();
+  m_FreeBatches.push_back(batchIndex);
+  m_Statistics.Batches--;
+}
+
+const StaticGeometry::Batch *
+StaticGeometry::FindBatch(EntityHandle handle) const {
+  auto it = m_Members.find(handle.Value);
+  return it != m_Members.end() ? &m_Batches[it->second.Batch] : nullptr;
+}
+
+} // namespace S67
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Renderer/Bounds.h"
+#include "Renderer/Components.h"
+#include "Renderer/EntityHandle.h"
+#include "Renderer/Shader.h"
+#include "Renderer/Texture.h"
+#include "Renderer/VertexArray.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace S67 {
+
+class Entity;
+class LevelStreamer;
+
+/**
+ * @brief Level geometry that never moves, merged into a few large meshes
+ *
+ * Anchored entities without scripts are grouped by shader, albedo texture and
+ * cell: the level streamer's chunk while streaming is on, so a chunk's
+ * batches come and go with it, or a square of r_staticbatch_cell on the XZ
+ * plane otherwise. Each group's meshes are read back from the GPU, baked into
+ * world space (tiling folded into the UVs) and uploaded as one vertex array
+ * with its world bounds. A cell of blockout then costs one culling test and
+ * one draw.
+ *
+ * Batches only hold weak references to what they were merged from, so the
+ * streamer can still free a far chunk's meshes and textures. Covers() is
+ * asked about each drawable entity every frame. A member that no longer
+ * matches what was merged (it moved, streamed out, or its mesh, material,
+ * flags or scripts changed) has its range cleared, and a batch left without
+ * live members is released. Its cell is then marked dirty, as is the cell of
+ * any entity that could be merged but isn't. Update() rebuilds a dirty cell
+ * once it has been left alone for a moment, so edited entities and chunks
+ * that streamed back in are merged again. Picking and selection go through
+ * the entities, so merging is invisible to the editor.
+ *
+ * Main thread, holding the simulation lock from Update() to EvictUnseen():
+ * scripts can anchor or unanchor entities mid-Play.
+ */
+class StaticGeometry {
+public:
+  struct Member {
+    EntityHandle Handle;
+    uint32_t FirstIndex = 0;
+    uint32_t IndexCount = 0;
+    // What it was merged from
+    glm::mat4 Transform;
+    std::weak_ptr<VertexArray> Mesh;
+    std::weak_ptr<Shader> MaterialShader;
+    std::weak_ptr<Texture2D> Albedo;
+    glm::vec2 Tiling;
+    uint32_t SeenStamp = 0;
+    bool Evicted = false;
+  };
+  struct Batch {
+    Ref<VertexArray> Mesh; // nullptr once released
+    Ref<Shader> MaterialShader;
+    std::weak_ptr<Texture2D> Albedo; // Tiling is baked in
+    bool Textured = false;
+    AABB Bounds;
+    int64_t Cell = 0;
+    std::vector<Member> Members;
+    uint32_t LiveMembers = 0;
+  };
+  struct Statistics {
+    uint32_t Batches = 0;    // With live members
+    uint32_t Merged = 0;     // Entities drawn by a batch
+    uint32_t Evicted = 0;    // Since every cell was last rebuilt
+    uint32_t DirtyCells = 0; // Waiting to be rebuilt
+  };
+
+  void Clear();
+  // Rebuilds every cell on the next Update(), for a freshly loaded level or
+  // the start of Play
+  void Invalidate() { m_RebuildAll = true; }
+  // Once a frame before the entities go through Covers(): rebuilds the
+  // cells that are due, from entities[i] as placed by transforms[i]
+  void Update(const std::vector<Ref<Entity>> &entities,
+              const std::vector<glm::mat4> &transforms,
+              const LevelStreamer &streamer);
+
+  // Whether a batch draws the entity at this transform. A member that no
+  // longer matches is evicted and false is returned from then on.
+  bool Covers(const Entity &entity, const glm::mat4 &transform);
+  // Once a frame after every drawable entity went through Covers(): evicts
+  // the members that were not asked about (deleted, or lost their mesh)
+  void EvictUnseen();
+
+  // Released batches are left in place without a mesh
+  const std::vector<Batch> &GetBatches() const { return m_Batches; }
+  // Batch drawing the entity, or nullptr
+  const Batch *FindBatch(EntityHandle handle) const;
+  const Statistics &GetStatistics() const { return m_Statistics; }
+
+  static bool IsEnabled();
+
+private:
+  // Frames a dirty cell must go unchanged before it is rebuilt, so a chunk
+  // streaming in or an entity being dragged is merged once, not every frame
+  static constexpr uint32_t SETTLE_FRAMES = 30;
+
+  struct MemberIndex {
+    uint32_t Batch;
+    uint32_t Member;
+  };
+  // A candidate that had nothing to merge with in its cell
+  struct Single {
+    Member Record;
+    int64_t Cell;
+  };
+
+  static bool IsCandidate(const Entity &entity);
+  static bool StillMatches(const Entity &entity, const glm::mat4 &transform,
+                           const Member &member);
+  int64_t GetCell(const glm::mat4 &transform) const;
+  void MarkDirty(int64_t cell);
+  // Merges the candidates in cells (every cell if null), replacing what was
+  // there
+  void Rebuild(const std::vector<Ref<Entity>> &entities,
+               const std::vector<glm::mat4> &transforms,
+               const std::unordered_set<int64_t> *cells);
+  void Evict(const MemberIndex &index);
+  void Release(uint32_t batchIndex);
+
+  std::vector<Batch> m_Batches;
+  std::vector<uint32_t> m_FreeBatches;
+  std::unordered_map<uint32_t, MemberIndex> m_Members; // Handle value
+  std::unordered_map<uint32_t, Single> m_Singles;      // Handle value
+  std::unordered_map<int64_t, uint32_t> m_DirtyCells;  // Stamp last dirtied
+  std::unordered_set<int64_t> m_DueCells;              // Scratch
+  Statistics m_Statistics;
+  uint32_t m_Stamp = 0;
+  bool m_RebuildAll = true;
+
+  // Cell layout the batches were built with
+  const LevelStreamer *m_Streamer = nullptr;
+  float m_CellSize = 0.0f;
+};
+
+} // namespace S67
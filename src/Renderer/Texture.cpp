@@ -7,16 +7,8 @@ namespace S67 {
 
     class OpenGLTexture2D : public Texture2D {
     public:
-        OpenGLTexture2D(const std::string& path)
-            : m_Path(path) {
-            int width, height, channels;
-            stbi_set_flip_vertically_on_load(1);
-            stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
-            S67_CORE_ASSERT(data, "Failed to load image!");
-
-            m_Width = width;
-            m_Height = height;
-
+        OpenGLTexture2D(const TextureData& data)
+            : m_Path(data.Path), m_Width(data.Width), m_Height(data.Height) {
             GLenum internalFormat = GL_RGBA8;
             GLenum dataFormat = GL_RGBA;
 
@@ -29,10 +21,8 @@ namespace S67 {
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, dataFormat, GL_UNSIGNED_BYTE, data.Pixels.data());
             glGenerateMipmap(GL_TEXTURE_2D);
-
-            stbi_image_free(data);
         }
 
         virtual ~OpenGLTexture2D() {
@@ -91,7 +81,34 @@ namespace S67 {
     };
 
     Ref<Texture2D> Texture2D::Create(const std::string& path) {
-        return CreateRef<OpenGLTexture2D>(path);
+        TextureData data;
+        if (!LoadData(path, data)) {
+            S67_CORE_ASSERT(false, "Failed to load image!");
+        }
+        return CreateRef<OpenGLTexture2D>(data);
+    }
+
+    Ref<Texture2D> Texture2D::Create(const TextureData& data) {
+        return CreateRef<OpenGLTexture2D>(data);
+    }
+
+    bool Texture2D::LoadData(const std::string& path, TextureData& data) {
+        // The flip flag is per thread, so worker decodes don't race the
+        // main thread (the window icon loads unflipped)
+        stbi_set_flip_vertically_on_load_thread(1);
+        data.Path = path;
+        int width, height, channels;
+        stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+        if (!pixels) {
+            S67_CORE_ERROR("Failed to load image: {0}", path);
+            return false;
+        }
+
+        data.Width = width;
+        data.Height = height;
+        data.Pixels.assign(pixels, pixels + (size_t)width * height * 4);
+        stbi_image_free(pixels);
+        return true;
     }
 
 }
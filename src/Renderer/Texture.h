@@ -2,6 +2,7 @@
 
 #include "Core/Base.h"
 #include <string>
+#include <vector>
 
 namespace S67 {
 
@@ -18,9 +19,22 @@ namespace S67 {
         virtual void Bind(uint32_t slot = 0) const = 0;
     };
 
+    // RGBA8 pixels decoded from an image file, before any GL texture exists
+    struct TextureData {
+        std::string Path;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        std::vector<uint8_t> Pixels;
+    };
+
     class Texture2D : public Texture {
     public:
         static Ref<Texture2D> Create(const std::string& path);
+        static Ref<Texture2D> Create(const TextureData& data);
+
+        // Decodes without touching GL state, so it can run on a worker thread;
+        // the pixels are then uploaded on the main thread with Create()
+        static bool LoadData(const std::string& path, TextureData& data);
     };
 
 }
@@ -0,0 +1,112 @@
+#include "TextureCache.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+namespace S67 {
+
+struct CacheEntry {
+  std::weak_ptr<Texture2D> Texture;
+  std::filesystem::file_time_type WriteTime; // Of the file when decoded
+};
+static std::unordered_map<std::string, CacheEntry> s_Textures;
+// Caller's spelling -> canonical path, so lookups skip the filesystem
+static std::unordered_map<std::string, std::string> s_CanonicalPaths;
+static uint32_t s_Hits = 0;
+static uint32_t s_Misses = 0;
+static uint32_t s_Failures = 0;
+// Kept by the textures' deleters, which may run wherever the last reference
+// is dropped
+static std::atomic<uint32_t> s_Resident{0};
+static std::atomic<uint64_t> s_ResidentBytes{0};
+
+static const std::string &Canonicalize(const std::string &path) {
+  auto [it, inserted] = s_CanonicalPaths.try_emplace(path);
+  if (inserted) {
+    std::error_code error;
+    std::filesystem::path canonical =
+        std::filesystem::weakly_canonical(path, error);
+    if (error)
+      canonical = std::filesystem::absolute(path, error).lexically_normal();
+    it->second = canonical.make_preferred().string();
+  }
+  return it->second;
+}
+
+static std::filesystem::file_time_type WriteTime(const std::string &path) {
+  std::error_code error;
+  auto writeTime = std::filesystem::last_write_time(path, error);
+  return error ? std::filesystem::file_time_type::min() : writeTime;
+}
+
+Ref<Texture2D> TextureCache::Find(const std::string &path) {
+  const std::string &key = Canonicalize(path);
+  auto it = s_Textures.find(key);
+  if (it == s_Textures.end())
+    return nullptr;
+
+  Ref<Texture2D> texture = it->second.Texture.lock();
+  if (!texture) {
+    s_Textures.erase(it);
+    return nullptr;
+  }
+  // Edited since it was decoded: a miss, replaced by the next Add()
+  if (WriteTime(key) != it->second.WriteTime)
+    return nullptr;
+
+  s_Hits++;
+  return texture;
+}
+
+Ref<Texture2D> TextureCache::Load(const std::string &path) {
+  if (Ref<Texture2D> texture = Find(path))
+    return texture;
+
+  TextureData data;
+  if (!Texture2D::LoadData(path, data)) {
+    s_Failures++;
+    return nullptr;
+  }
+  return Add(data);
+}
+
+Ref<Texture2D> TextureCache::Add(const TextureData &data) {
+  const std::string &key = Canonicalize(data.Path);
+  auto writeTime = WriteTime(key);
+  CacheEntry &entry = s_Textures[key];
+  if (Ref<Texture2D> texture = entry.Texture.lock()) {
+    if (entry.WriteTime == writeTime)
+      return texture;
+  }
+
+  // The texture keeps the caller's path (levels store it relative to the
+  // project); only the key is canonical. The outer reference counts it
+  // resident until the last user lets go, then releases the GL texture.
+  Ref<Texture2D> created = Texture2D::Create(data);
+  uint64_t bytes = (uint64_t)created->GetWidth() * created->GetHeight() * 4 *
+                   4 / 3; // A full mip chain adds a third
+  s_Resident++;
+  s_ResidentBytes += bytes;
+  Ref<Texture2D> texture(created.get(), [created, bytes](Texture2D *) mutable {
+    s_Resident--;
+    s_ResidentBytes -= bytes;
+    created.reset();
+  });
+
+  entry = {texture, writeTime};
+  s_Misses++;
+  return texture;
+}
+
+TextureCache::Statistics TextureCache::GetStatistics() {
+  Statistics statistics;
+  statistics.Hits = s_Hits;
+  statistics.Misses = s_Misses;
+  statistics.Failures = s_Failures;
+  statistics.Resident = s_Resident;
+  statistics.ResidentBytes = s_ResidentBytes;
+  return statistics;
+}
+
+} // namespace S67
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Renderer/Texture.h"
+#include <cstdint>
+#include <string>
+
+namespace S67 {
+
+/**
+ * @brief One GL texture per image file, shared by everything that uses it
+ *
+ * Textures are keyed by canonical path and held weakly: the cache never
+ * keeps a texture alive, so it is freed as soon as the last material, panel
+ * or streamer holding it lets go, and decoded again on the next request. A
+ * file written since its texture was decoded is a miss, so edited images
+ * are picked up when they are next loaded. Main thread only, like every GL
+ * upload; the level streamer decodes on its workers and hands the pixels to
+ * Add().
+ */
+class TextureCache {
+public:
+  struct Statistics {
+    uint32_t Hits = 0;
+    uint32_t Misses = 0;   // Decoded and uploaded
+    uint32_t Failures = 0; // Files that could not be decoded
+    uint32_t Resident = 0; // Alive right now
+    uint64_t ResidentBytes = 0; // Estimated, RGBA8 with mipmaps
+  };
+
+  // The live texture for the file, or a freshly loaded one; nullptr if the
+  // file can't be read
+  static Ref<Texture2D> Load(const std::string &path);
+  // The live, up to date texture for the file, without loading it
+  static Ref<Texture2D> Find(const std::string &path);
+  // Uploads pixels decoded elsewhere, unless the same version of the file
+  // became resident meanwhile, in which case that texture is returned
+  static Ref<Texture2D> Add(const TextureData &data);
+
+  static Statistics GetStatistics();
+};
+
+} // namespace S67
@@ -42,7 +42,10 @@ namespace S67 {
         OpenGLVertexArray(OpenGLVertexArray&& other) noexcept
             : m_RendererID(other.m_RendererID),
               m_VertexBuffers(std::move(other.m_VertexBuffers)),
-              m_IndexBuffer(std::move(other.m_IndexBuffer)) {
+              m_IndexBuffer(std::move(other.m_IndexBuffer)),
+              m_InstanceBuffer(std::move(other.m_InstanceBuffer)),
+              m_Bounds(other.m_Bounds),
+              m_BoundingSphere(other.m_BoundingSphere) {
             other.m_RendererID = 0;
         }
 
@@ -57,6 +60,9 @@ namespace S67 {
                 m_RendererID = other.m_RendererID;
                 m_VertexBuffers = std::move(other.m_VertexBuffers);
                 m_IndexBuffer = std::move(other.m_IndexBuffer);
+                m_InstanceBuffer = std::move(other.m_InstanceBuffer);
+                m_Bounds = other.m_Bounds;
+                m_BoundingSphere = other.m_BoundingSphere;
                 
                 // Nullify moved-from object
                 other.m_RendererID = 0;
@@ -101,13 +107,53 @@ namespace S67 {
             m_IndexBuffer = indexBuffer;
         }
 
+        virtual void SetInstanceBuffer(const Ref<VertexBuffer>& instanceBuffer, uint32_t firstLocation, uint32_t firstInstance) override {
+            glBindVertexArray(m_RendererID);
+            instanceBuffer->Bind();
+
+            const auto& layout = instanceBuffer->GetLayout();
+            size_t base = (size_t)firstInstance * layout.GetStride();
+            uint32_t location = firstLocation;
+            for (const auto& element : layout) {
+                // A matrix is one vec4 attribute per column
+                bool matrix = element.Type == ShaderDataType::Mat4;
+                uint32_t columns = matrix ? 4 : 1;
+                for (uint32_t column = 0; column < columns; column++) {
+                    if (m_InstanceBuffer != instanceBuffer) {
+                        glEnableVertexAttribArray(location);
+                        glVertexAttribDivisor(location, 1);
+                    }
+                    glVertexAttribPointer(location,
+                                          matrix ? 4 : element.GetComponentCount(),
+                                          ShaderDataTypeToOpenGLBaseType(element.Type),
+                                          element.Normalized ? GL_TRUE : GL_FALSE,
+                                          layout.GetStride(),
+                                          (const void*)(base + element.Offset + column * sizeof(float) * 4));
+                    location++;
+                }
+            }
+            m_InstanceBuffer = instanceBuffer;
+        }
+
         virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
         virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
 
+        virtual void SetBounds(const AABB& bounds, const BoundingSphere& sphere) override {
+            m_Bounds = bounds;
+            m_BoundingSphere = sphere;
+        }
+        virtual const AABB& GetBounds() const override { return m_Bounds; }
+        virtual const BoundingSphere& GetBoundingSphere() const override { return m_BoundingSphere; }
+
+        virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
     private:
         uint32_t m_RendererID = 0;
         std::vector<Ref<VertexBuffer>> m_VertexBuffers;
         Ref<IndexBuffer> m_IndexBuffer;
+        Ref<VertexBuffer> m_InstanceBuffer;
+        AABB m_Bounds;
+        BoundingSphere m_BoundingSphere;
     };
 
     Ref<VertexArray> VertexArray::Create() {
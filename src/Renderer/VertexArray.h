@@ -2,6 +2,7 @@
 
 #include <memory>
 #include "Buffer.h"
+#include "Bounds.h"
 
 namespace S67 {
 
@@ -14,10 +15,22 @@ namespace S67 {
 
         virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) = 0;
         virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) = 0;
+        // Binds the array and points the attributes from firstLocation on at
+        // a per-instance buffer (Mat4 elements take four locations), starting
+        // at instance firstInstance. Called again to draw from another offset.
+        virtual void SetInstanceBuffer(const Ref<VertexBuffer>& instanceBuffer, uint32_t firstLocation, uint32_t firstInstance) = 0;
 
         virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const = 0;
         virtual const Ref<IndexBuffer>& GetIndexBuffer() const = 0;
 
+        // Local-space bounds of the positions, used for culling. MeshLoader
+        // fills them in; arrays built by hand get the unit cube unless set.
+        virtual void SetBounds(const AABB& bounds, const BoundingSphere& sphere) = 0;
+        virtual const AABB& GetBounds() const = 0;
+        virtual const BoundingSphere& GetBoundingSphere() const = 0;
+
+        virtual uint32_t GetRendererID() const = 0;
+
         static Ref<VertexArray> Create();
     };
 
@@ -118,7 +118,7 @@ namespace S67 {
                     PhysicsSystem::GetBodyInterface().SetMotionType(self.PhysicsBody, anchored ? JPH::EMotionType::Kinematic : JPH::EMotionType::Dynamic, JPH::EActivation::Activate);
                 }
             },
-            "isAnchored", &Entity::Anchored,
+            "isAnchored", [](Entity& self) { return self.Anchored; },
             "setRotation", [](Entity& self, const glm::vec3& euler) {
                 self.Transform.Rotation = euler;
                 if (!self.PhysicsBody.IsInvalid()) {
@@ -154,6 +154,70 @@ namespace S67 {
             return Application::Get().GetScene().FindEntityByName(name).get();
         });
 
+        s_State.set_function("findEntitiesWithTag", [](const std::string& tag) {
+            Scene& scene = Application::Get().GetScene();
+            std::vector<Entity*> entities;
+            for (EntityHandle handle : scene.FindEntitiesByTag(tag)) {
+                if (Ref<Entity> entity = scene.GetEntity(handle))
+                    entities.push_back(entity.get());
+            }
+            return sol::as_table(entities);
+        });
+
+        // Spatial queries against entity bounds (see EntityRegistry)
+        auto resolve = [](const std::vector<EntityHandle>& handles) {
+            Scene& scene = Application::Get().GetScene();
+            std::vector<Entity*> entities;
+            entities.reserve(handles.size());
+            for (EntityHandle handle : handles) {
+                if (Ref<Entity> entity = scene.GetEntity(handle))
+                    entities.push_back(entity.get());
+            }
+            return sol::as_table(entities);
+        };
+
+        s_State.set_function("findEntitiesInRadius", [resolve](const glm::vec3& center, float radius) {
+            std::vector<EntityHandle> handles;
+            Application::Get().GetScene().GetRegistry().QuerySphere(center, radius, handles);
+            return resolve(handles);
+        });
+
+        s_State.set_function("findEntitiesInBox", [resolve](const glm::vec3& min, const glm::vec3& max) {
+            std::vector<EntityHandle> handles;
+            Application::Get().GetScene().GetRegistry().QueryBox({min, max}, handles);
+            return resolve(handles);
+        });
+
+        // Entities the player can see. Scripts run on the simulation thread,
+        // so this is the simulation-side player camera, not the game view's.
+        s_State.set_function("findEntitiesInView", [resolve]() {
+            std::vector<EntityHandle> handles;
+            Frustum frustum = Frustum::FromMatrix(Application::Get().GetPlayerCamera()->GetViewProjectionMatrix());
+            Application::Get().GetScene().GetRegistry().QueryFrustum(frustum, handles);
+            return resolve(handles);
+        });
+
+        // Nearest entity to 'from' (excluding it), optionally with a tag
+        s_State.set_function("findNearestEntity", [](Entity* from, float maxDistance, sol::optional<std::string> tag) -> Entity* {
+            if (!from) return nullptr;
+            Scene& scene = Application::Get().GetScene();
+            const EntityRegistry& registry = scene.GetRegistry();
+            EntityHandle self = from->GetHandle();
+            std::string wanted = tag.value_or("");
+            EntityHandle nearest = registry.FindNearest(glm::vec3(registry.GetWorldTransform(self)[3]), maxDistance,
+                [&](EntityHandle handle) {
+                    return handle != self && (wanted.empty() || registry.HasTag(handle, wanted));
+                });
+            return scene.GetEntity(nearest).get();
+        });
+
+        // Hits any entity, collidable or not
+        s_State.set_function("raycastEntities", [](const glm::vec3& origin, const glm::vec3& direction, sol::optional<float> distance) -> Entity* {
+            Scene& scene = Application::Get().GetScene();
+            EntityHandle hit = scene.GetRegistry().Raycast(origin, direction, distance.value_or(100.0f));
+            return scene.GetEntity(hit).get();
+        });
+
         s_State.set_function("isKeyHeld", [](int key) {
             return Input::IsKeyPressed(key);
         });
@@ -187,11 +251,7 @@ namespace S67 {
             direction = glm::normalize(direction);
 
             JPH::BodyID hitBody = PhysicsSystem::Raycast(origin, direction, distance);
-            if (!hitBody.IsInvalid()) {
-                auto& bodyInterface = PhysicsSystem::GetBodyInterface();
-                return (Entity*)bodyInterface.GetUserData(hitBody);
-            }
-            return nullptr;
+            return Application::Get().GetScene().GetEntity(PhysicsSystem::GetBodyEntity(hitBody)).get();
         });
     }
 